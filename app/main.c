@@ -10,80 +10,444 @@
 /*-----------------------------------------------------------------
                               Includes
   -----------------------------------------------------------------*/
+#include <getopt.h>
+#include <stdbool.h>
 #include <stdio.h>
 #include <stdint.h>
+#include <stdlib.h>
 #include <string.h>
 #include "../include/error-handler.h"
 #include "../include/bbp.h"
+#include "../include/bench.h"
+#include "../include/cost.h"
+#include "../include/formula.h"
+#include "../include/hybrid.h"
 #include "../include/menu2.h"
+#include "../include/output.h"
 #include "../include/pages.h"
+#include "../include/range.h"
+#include "../include/repeat.h"
+#include "../include/report.h"
+#include "../include/server.h"
+#include "../include/topology.h"
+#include "../include/verify.h"
+
+
+/*-----------------------------------------------------------------
+                            Definitions
+  -----------------------------------------------------------------*/
+#define USAGE "[algorithm] [offset] [threads|auto] ([digits] [file] [format]) [options]\n" \
+	"  Or:   --algo=NAME --offset=N --threads=N|auto [options]\n\n" \
+	"  -a, --algo=NAME         bellard (default), original, adamchik, log2, pi2\n" \
+	"                          or \"key base signs power m,j,l,coef ...\"\n" \
+	"  -o, --offset=N          Starting Position (Default 0)\n" \
+	"  -t, --threads=N|auto    Threads (Default 1, auto = Every CPU)\n" \
+	"  -d, --digits=1-16       Hex Digits Wanted (Default 10)\n" \
+	"  -b, --batch=N           Elements Per Batch (Default 100)\n" \
+	"  -k, --kernel=MODE       auto (default), generic, wide\n" \
+	"  -p, --pin=POLICY        none (default), cores, cpus\n" \
+	"  -s, --scheduler=MODE    weighted (default), equal, static\n" \
+	"  -r, --report=FORMAT     text (default), json, csv\n" \
+	"      --no-smt            Same as --pin=cores\n" \
+	"      --estimate          Predict Time Instead of Running\n" \
+	"      --first             Hybrid Mode Returns The First Result\n" \
+	"                          (Hybrid Prints 10 Hex Digits as Text and Takes no\n" \
+	"                          --digits, --report, --estimate or --repeat)\n" \
+	"      --repeat=N          Time N Runs, Report Min, Median, P90, Stddev\n" \
+	"      --warmup=M          Untimed Runs Before Them (Default 0)\n" \
+	"  -h, --help              This Message\n\n" \
+	"  [Format] = hex (default), bin, oct, raw"
+
+
+/*-----------------------------------------------------------------
+                          Structs and Enums
+  -----------------------------------------------------------------*/
+
+// Options of The Command Line, Positional Arguments Stay in argv
+typedef struct {
+	Config configs;       // Settings Given by Options
+	bool named;           // Algorithm, Offset or Threads Given as Options
+	bool autoThreads;     // Threads Set to The CPUs Available
+	bool estimate;        // Cost Model Prediction Instead of a Run
+	bool first;           // Hybrid Mode Returns The First Result
+	uint32_t repeat;      // Timed Runs (0 = Single Run, Not Summarized)
+	uint32_t warmup;      // Untimed Runs Before Them
+} Options;
+
+
+/*-----------------------------------------------------------------
+                          Global Variables
+  -----------------------------------------------------------------*/
+static const struct option longOptions[] = {
+	{"algo",      required_argument, NULL, 'a'},
+	{"offset",    required_argument, NULL, 'o'},
+	{"threads",   required_argument, NULL, 't'},
+	{"digits",    required_argument, NULL, 'd'},
+	{"batch",     required_argument, NULL, 'b'},
+	{"kernel",    required_argument, NULL, 'k'},
+	{"pin",       required_argument, NULL, 'p'},
+	{"scheduler", required_argument, NULL, 's'},
+	{"report",    required_argument, NULL, 'r'},
+	{"no-smt",    no_argument,       NULL, 'n'},
+	{"estimate",  no_argument,       NULL, 'e'},
+	{"first",     no_argument,       NULL, 'f'},
+	{"repeat",    required_argument, NULL, 'R'},
+	{"warmup",    required_argument, NULL, 'W'},
+	{"help",      no_argument,       NULL, 'h'},
+	{NULL, 0, NULL, 0}
+};
 
 
 /*-----------------------------------------------------------------
                       Functions Implementation
   -----------------------------------------------------------------*/
-Config* parseArguments(int argc, char* argv[]) {
+int parseAlgorithm(const char* name) {
 
-	Config *configs = NULL;
-	uint64_t offset;
-	uint32_t threads;
-	Algorithm algo;
-        
-	if (argc != 4) {
-		invalidProgramCall(argv[0], "[algorithm] [offset] [threads]\n  [Algorithm] = bellard, original");
+	Formula userFormula;
+	int algo = findFormula(name);
+
+	// Not a Known Formula, Try to Parse a Description
+	if (algo == -1) {
+
+		if (parseFormula(name, &userFormula)) {
+			invalidArgumentError("Invalid Algorithm! [bellard, original, adamchik, log2, pi2, formula]");
+		}
+
+		algo = registerFormula(&userFormula);
+
+		if (algo == -1) {
+			invalidArgumentError("Formula Couldn't Be Registered!");
+		}
 	}
 
-	if (!strcmp(argv[1], "bellard"))
-		algo = BELLARD;
-	else if (!strcmp(argv[1], "original"))
-		algo = BBP_ORIGINAL;
-	else{
-		invalidArgumentError("Invalid Algorithm! [bellard, orginal]");
-	}	
-        
-    offset = strtoll(argv[2], NULL, 10);
-    threads = strtoll(argv[3], NULL, 10);
-    
-	if (offset < 0) {
-		invalidArgumentError("Invalid Offset");
+	return algo;
+}
+
+uint64_t parseNumber(const char* text, const char* error) {
+
+	char* end;
+	uint64_t number = strtoull(text, &end, 10);
+
+	if (end == text || *end != '\0' || *text == '-') {
+		invalidArgumentError(error);
 	}
 
-	if (threads < 1 || threads > 65536) {
-		invalidArgumentError("Invalid Numvber of Threads!\n1 < Threads < 65536");
+	return number;
+}
+
+void parseThreads(const char* text, Options* options) {
+
+	uint64_t threads;
+
+	// Resolved Once Every Option is Known (Pinning Changes The Count)
+	if (!strcmp(text, "auto")) {
+		options -> autoThreads = true;
+		return;
 	}
 
+	threads = parseNumber(text, "Invalid Number of Threads!\n1 <= Threads <= 65535 or auto");
+
+	if (threads < 1 || threads > UINT16_MAX) {
+		invalidArgumentError("Invalid Number of Threads!\n1 <= Threads <= 65535 or auto");
+	}
+
+	options -> configs.nthreads = threads;
+	options -> autoThreads = false;
+}
+
+void parseOptions(int* argc, char* argv[], Options* options) {
+
+	uint64_t value;
+	int option, kept = 1;
+
+	memset(options, 0, sizeof(Options));
+	options -> configs.algo = BELLARD;
+	options -> configs.nthreads = 1;
+	options -> configs.report = REPORT_TEXT;
+
+	// Options May Appear Anywhere, getopt Moves Them Before The Rest
+	while ((option = getopt_long(*argc, argv, "a:o:t:d:b:k:p:s:r:h", longOptions, NULL)) != -1) {
+
+		switch (option) {
+			case 'a':
+				options -> configs.algo = parseAlgorithm(optarg);
+				options -> named = true;
+				break;
+			case 'o':
+				options -> configs.startPos = parseNumber(optarg, "Invalid Offset!");
+				options -> named = true;
+				break;
+			case 't':
+				parseThreads(optarg, options);
+				options -> named = true;
+				break;
+			case 'd':
+				value = parseNumber(optarg, "Invalid Number of Digits! [1-16]");
+
+				if (!value || value > MAX_DIGITS) {
+					invalidArgumentError("Invalid Number of Digits! [1-16]");
+				}
+
+				options -> configs.digits = value;
+				break;
+			case 'b':
+				value = parseNumber(optarg, "Invalid Batch Size!");
+
+				if (!value) {
+					invalidArgumentError("Invalid Batch Size!");
+				}
+
+				options -> configs.batchSize = value;
+				break;
+			case 'k':
+				if (parseKernel(optarg, &options -> configs.kernel)) {
+					invalidArgumentError("Invalid Kernel! [auto, generic, wide]");
+				}
+				break;
+			case 'p':
+				if (parsePinning(optarg, &options -> configs.pinning)) {
+					invalidArgumentError("Invalid Pinning Policy! [none, cores, cpus]");
+				}
+				break;
+			case 's':
+				if (parseScheduler(optarg, &options -> configs.scheduler)) {
+					invalidArgumentError("Invalid Scheduler! [weighted, equal, static]");
+				}
+				break;
+			case 'r':
+				if (parseReportFormat(optarg, &options -> configs.report)) {
+					invalidArgumentError("Invalid Report Format! [text, json, csv]");
+				}
+				break;
+			case 'n':
+				options -> configs.pinning = PIN_CORES;
+				break;
+			case 'e':
+				options -> estimate = true;
+				break;
+			case 'f':
+				options -> first = true;
+				break;
+			case 'R':
+				value = parseNumber(optarg, "Invalid Number of Runs!");
+
+				if (!value || value > UINT32_MAX) {
+					invalidArgumentError("Invalid Number of Runs!");
+				}
+
+				options -> repeat = value;
+				break;
+			case 'W':
+				value = parseNumber(optarg, "Invalid Number of Warm-Up Runs!");
+
+				if (value > UINT32_MAX) {
+					invalidArgumentError("Invalid Number of Warm-Up Runs!");
+				}
+
+				options -> warmup = value;
+				break;
+			case 'h':
+				printf("Usage: \n %s %s\n", argv[0], USAGE);
+				exit(EXIT_SUCCESS);
+			default:
+				invalidProgramCall(argv[0], USAGE);
+		}
+	}
+
+	// Positional Arguments Right After The Program Name
+	for (int i = optind; i < *argc; i++)
+		argv[kept++] = argv[i];
+
+	*argc = kept;
+}
+
+void resolveThreads(Options* options) {
+
+	const Topology* machine;
+
+	if (!options -> autoThreads)
+		return;
+
+	machine = getTopology();
+	options -> configs.nthreads = (options -> configs.pinning == PIN_CORES) ?
+	                              machine -> cores : machine -> total;
+}
+
+Config* parseArguments(int argc, char* argv[], Options* options) {
+
+	Config *configs = NULL;
+
+	// Positional Form Overrides Named Algorithm, Offset and Threads
+	if (argc != 1 && argc != 4 && argc != 6 && argc != 7) {
+		invalidProgramCall(argv[0], USAGE);
+	}
+
+	if (argc > 1) {
+		options -> configs.algo = parseAlgorithm(argv[1]);
+		options -> configs.startPos = parseNumber(argv[2], "Invalid Offset!");
+		parseThreads(argv[3], options);
+	}
+
+	resolveThreads(options);
+
 	configs = (Config *)malloc(sizeof(Config));
 	checkNullPointer((void *)configs);
 
-	configs->algo = algo;
-	configs->startPos = offset;
-	configs->nthreads = threads;
+	*configs = options -> configs;
         
 	return configs;
 }
 
+int runEstimate(Config* configs) {
+
+	CostEstimate estimate;
+
+	if (estimateCost(configs, 0, &estimate)) {
+		invalidArgumentException("Algorithm Not Found or Offset Too Large For Formula!");
+		return 1;
+	}
+
+	printf("\nEstimate @ %lu (%d Threads, %d at Once, Batch %lu):\n",
+	       configs -> startPos, configs -> nthreads, estimate.parallel, estimate.batchSize);
+	printf("Wall Time: %.5fs\n", estimate.wallTime);
+	printf("CPU Time:  %.5fs (Left %.5fs, Right %.5fs, Threads %.5fs)\n",
+	       estimate.cpuTime, estimate.leftTime, estimate.rightTime, estimate.threadTime);
+	printf("Terms:     %lu\n", estimate.terms);
+
+	return 0;
+}
+
+int runRange(Config* configs, int argc, char* argv[]) {
+
+	DigitFormat format = DIGITS_HEX;
+	char* end;
+	uint64_t digits = strtoull(argv[4], &end, 10);
+
+	if (*end != '\0' || !digits) {
+		invalidArgumentError("Invalid Number of Digits!");
+	}
+
+	if (argc == 7 && parseDigitFormat(argv[6], &format)) {
+		invalidArgumentError("Invalid Format! [hex, bin, oct, raw]");
+	}
+
+	return calcRange(configs, digits, format, argv[5]);
+}
+
 
 /*-----------------------------------------------------------------
                                Main
   -----------------------------------------------------------------*/
 int main(int argc, char* argv[]) {
 
+	Options options;
+	int ret = 0;
+
+	parseOptions(&argc, argv, &options);
+
+	// Self Check Mode: verify [threads] [baseline terms/s]
+	if (argc > 1 && !strcmp(argv[1], "verify")) {
+		uint16_t threads = (argc > 2) ? strtoul(argv[2], NULL, 10) : 1;
+		double baseline = (argc > 3) ? strtod(argv[3], NULL) : 0.0;
+
+		return runVerify((threads) ? threads : 1, baseline) != 0;
+	}
+
+	// Cores, SMT Siblings and Caches Seen by The Workers
+	if (argc == 2 && !strcmp(argv[1], "topology")) {
+		printTopology(getTopology());
+		return 0;
+	}
+
+	// Microbenchmark of Modular Primitives
+	if (argc == 2 && !strcmp(argv[1], "bench")) {
+		runBench(options.configs.report);
+		return 0;
+	}
+
+	// Digit Server: serve [socket] [threads]
+	if (argc > 1 && !strcmp(argv[1], "serve")) {
+		uint16_t threads = (argc > 3) ? strtoul(argv[3], NULL, 10) : 1;
+
+		return runServer((argc > 2) ? argv[2] : DEFAULT_SOCKET, (threads) ? threads : 1) != 0;
+	}
+
+	// Client of Digit Server: client [socket] ([request words] | stdin)
+	if (argc > 1 && !strcmp(argv[1], "client")) {
+		char request[256] = "";
+
+		for (int i = 3; i < argc; i++)
+			snprintf(request + strlen(request), sizeof(request) - strlen(request),
+			         (i > 3) ? " %s" : "%s", argv[i]);
+
+		return runClient((argc > 2) ? argv[2] : DEFAULT_SOCKET,
+		                 (argc > 3) ? request : NULL) != 0;
+	}
+
+	// Both Pi Formulas at Once: hybrid [offset] [threads] [--first]
+	if (argc > 1 && !strcmp(argv[1], "hybrid")) {
+		Config configs;
+
+		if (argc != 4) {
+			invalidProgramCall(argv[0], "hybrid [offset] [threads|auto] [--first] [options]");
+		}
+
+		// Digits Are Fixed to The Ones Cross-Checked, Printed as Text
+		if (options.configs.digits || options.configs.report != REPORT_TEXT ||
+		    options.estimate || options.repeat || options.warmup) {
+			invalidArgumentError("Hybrid Mode Takes no --digits, --report, --estimate or --repeat!");
+		}
+
+		options.configs.startPos = parseNumber(argv[2], "Invalid Offset!");
+		parseThreads(argv[3], &options);
+		resolveThreads(&options);
+
+		configs = options.configs;
+		configs.algo = BBP_ORIGINAL;
+
+		return calcHybrid(&configs, (options.first) ? HYBRID_FIRST : HYBRID_VERIFY);
+	}
+
 	// Menu Mode
-	if (argc == 1) {    
+	if (argc == 1 && !options.named) {    
 	    MenuSt* menu = initPages();
         
 		runMenu(menu);
-		freeMenu(menu);
+		freePages(menu);
 	} else {
 
-	    Config* configs = parseArguments(argc, argv);
+	    Config* configs = parseArguments(argc, argv, &options);
 
 		if (!configs)
 			return 1;
 
-		calcBBP(configs);
+		// Cost Model Prediction Instead of a Run
+		if (options.estimate) {
+			ret = runEstimate(configs);
+
+			free(configs);
+			return ret;
+		}
+
+		// Range Mode
+		if (argc > 4) {
+			ret = runRange(configs, argc, argv);
+
+			free(configs);
+			return ret;
+		}
+
+		// Timing Summary of Several Runs: --repeat=N [--warmup=M]
+		if (options.repeat || options.warmup) {
+			ret = calcRepeated(configs, (options.repeat) ? options.repeat : 1, options.warmup);
+
+			free(configs);
+			return ret;
+		}
+
+		ret = calcBBP(configs);
 		free(configs);		
 	}
 	
-	return 0;
+	return ret;
 }
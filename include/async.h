@@ -0,0 +1,185 @@
+/*-----------------------------------------------------------------*/
+/**
+
+  @file   async.h
+  @author Flávio M.
+
+ */
+/*-----------------------------------------------------------------*/
+
+#ifndef ASYNC_HEADER_FILE
+#define ASYNC_HEADER_FILE
+
+/*-----------------------------------------------------------------
+                              Includes
+  -----------------------------------------------------------------*/
+#include <stdint.h>
+#include "bbp.h"
+
+
+/*-----------------------------------------------------------------
+                          Structs and Enums
+  -----------------------------------------------------------------*/
+
+typedef struct bbpFuture BBPFuture;
+
+// Called From a Pool Worker When a Future Settles (Done or Cancelled)
+typedef void (*BBPCallback)(BBPFuture*, void*);
+
+// Scheduling of a Job (NULL Options = Priority 0, No Deadline)
+typedef struct {
+	int priority;      // Higher Runs First, Each Level Doubles The Weight
+	double deadline;   // Seconds After Submission (0 = None)
+} JobOptions;
+
+typedef enum {
+	FUTURE_PENDING,    // Still Running (or Wait Timed Out)
+	FUTURE_DONE,       // Result Available
+	FUTURE_CANCELLED   // Stopped Before Finishing, No Result
+}FutureState;
+
+// Progress of a Job, Read While it Runs
+typedef struct {
+	double fraction;      // Left Summation Done (0 to 1)
+	double elapsed;       // Seconds Since First Batch (0 = Queued)
+	double termsPerSec;   // Terms Evaluated Per Second so Far
+} BBPProgress;
+
+
+/*-----------------------------------------------------------------
+                  External Functions Declarations
+  -----------------------------------------------------------------*/
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Start The Worker Pool Shared by Every Submitted Job.
+           Each Free Worker Takes One Batch of The Most Urgent Job:
+           Jobs That Would Miss Their Deadline First (Earliest
+           Deadline), Then The Smallest Remaining Work Divided by
+           Priority Weight. The Weight of a Job Doubles For Every
+           AGING_SECONDS Without a Batch, so Large Jobs Keep Making
+           Progress. Workers Are Pinned by The Pinning Policy, as
+           The Threads of a Synchronous Job (One Per Physical Core
+           May Start Fewer Workers).
+   @param  uint16_t  Number of Workers.
+   @param  PinPolicy Placement of Workers.
+   @return int       Error(1) /Success(0) Code in Operation.
+*/
+/*-----------------------------------------------------------------*/
+int initAsync(uint16_t, PinPolicy);
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Number of Workers in The Pool.
+   @return uint16_t Workers Started (0 = Pool Not Running).
+*/
+/*-----------------------------------------------------------------*/
+uint16_t workersAsync();
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Cancel Every Pending Job and Stop The Worker Pool.
+           Futures Still Have to be Freed by Their Owners.
+*/
+/*-----------------------------------------------------------------*/
+void freeAsync();
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Submit a Computation to The Pool (Config nthreads is
+           Ignored, Jobs Share The Pool Workers).
+   @param  const Config* Configuration of Computation.
+   @param  const JobOptions* Priority and Deadline (May be NULL).
+   @param  BBPCallback   Called When The Future Settles (May be NULL).
+                         Must Not Free The Future.
+   @param  void*         User Data Passed to Callback.
+   @return BBPFuture*    Handle of Job / NULL if Config is Invalid or
+                         Pool is Not Running.
+*/
+/*-----------------------------------------------------------------*/
+BBPFuture* submitBBP(const Config*, const JobOptions*, BBPCallback, void*);
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Block Until a Future Settles.
+   @param  BBPFuture*   Handle of Job.
+   @param  long double* Result, Set if Done (May be NULL).
+   @return FutureState  FUTURE_DONE or FUTURE_CANCELLED.
+*/
+/*-----------------------------------------------------------------*/
+FutureState waitBBP(BBPFuture*, long double*);
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Block Until a Future Settles or a Timeout Expires.
+   @param  BBPFuture*   Handle of Job.
+   @param  double       Timeout in Seconds.
+   @param  long double* Result, Set if Done (May be NULL).
+   @return FutureState  FUTURE_PENDING on Timeout.
+*/
+/*-----------------------------------------------------------------*/
+FutureState timedWaitBBP(BBPFuture*, double, long double*);
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Get The State of a Future Without Blocking.
+   @param  BBPFuture*   Handle of Job.
+   @param  long double* Result, Set if Done (May be NULL).
+   @return FutureState  Current State.
+*/
+/*-----------------------------------------------------------------*/
+FutureState tryGetBBP(BBPFuture*, long double*);
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Measurements of a Settled Job: queueTime From Submission
+           to its First Batch, leftTime From First to Last Batch,
+           totalTime From Submission to Result.
+   @param  BBPFuture*  Handle of Job.
+   @param  BBPStats*   Measurements, Set if Settled.
+   @return FutureState Current State.
+*/
+/*-----------------------------------------------------------------*/
+FutureState statsBBP(BBPFuture*, BBPStats*);
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Progress of a Job Without Blocking. Batches Still Running
+           Don't Count as Done.
+   @param  BBPFuture*   Handle of Job.
+   @param  BBPProgress* Progress, Set in Every State.
+   @return FutureState  Current State.
+*/
+/*-----------------------------------------------------------------*/
+FutureState progressBBP(BBPFuture*, BBPProgress*);
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Cancel a Job. Workers Stop Taking its Batches at Once and
+           The Future Settles When The Batches in Flight End, so
+           Threads Are Released Within One Batch.
+   @param  BBPFuture* Handle of Job.
+*/
+/*-----------------------------------------------------------------*/
+void cancelBBP(BBPFuture*);
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Free a Future, Cancelling it And Waiting For it to Settle
+           if Still Pending.
+   @param  BBPFuture* Handle of Job.
+*/
+/*-----------------------------------------------------------------*/
+void freeFuture(BBPFuture*);
+
+#endif
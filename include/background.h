@@ -0,0 +1,99 @@
+/*-----------------------------------------------------------------*/
+/**
+
+  @file   background.h
+  @author Flávio M.
+
+ */
+/*-----------------------------------------------------------------*/
+
+#ifndef BACKGROUND_HEADER_FILE
+#define BACKGROUND_HEADER_FILE
+
+/*-----------------------------------------------------------------
+                              Includes
+  -----------------------------------------------------------------*/
+#include <stdint.h>
+#include <stdio.h>
+#include "bbp.h"
+
+
+/*-----------------------------------------------------------------
+                            Definitions
+  -----------------------------------------------------------------*/
+#define MAX_BACKGROUND_JOBS 64   // Jobs Kept, Oldest Finished Ones Are Dropped
+
+
+/*-----------------------------------------------------------------
+                  External Functions Declarations
+  -----------------------------------------------------------------*/
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Queue a Computation on The Asynchronous Pool, Started on
+           First Use With The Config Threads. The Pool is Restarted
+           With a New Thread Count Only When no Job is Running.
+   @param  const Config* Configuration of Computation.
+   @return int           Id of Job / -1 on Error.
+*/
+/*-----------------------------------------------------------------*/
+int queueComputation(const Config*);
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Cancel a Queued or Running Job.
+   @param  int Id of Job.
+   @return int Error(1) /Success(0) Code in Operation.
+*/
+/*-----------------------------------------------------------------*/
+int cancelComputation(int);
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Stream Progress and Throughput of Running Jobs, Printing
+           Each Result as it Arrives, Until Every Job Ended or Enter
+           is Pressed (Jobs Keep Running).
+   @return int Number of Jobs Still Running.
+*/
+/*-----------------------------------------------------------------*/
+int watchComputations();
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Collect Finished Jobs and Count The Others.
+   @return int Number of Jobs Still Running or Queued.
+*/
+/*-----------------------------------------------------------------*/
+int runningComputations();
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Write a Table of The Jobs Still Running or Queued.
+   @param  char*  Buffer.
+   @param  size_t Size of Buffer.
+   @return int    Number of Jobs Listed.
+*/
+/*-----------------------------------------------------------------*/
+int listComputations(char*, size_t);
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief Print Every Job Kept, With Results and Timings.
+*/
+/*-----------------------------------------------------------------*/
+void printHistory();
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief Cancel Every Job, Free Them and Stop The Pool.
+*/
+/*-----------------------------------------------------------------*/
+void freeComputations();
+
+#endif
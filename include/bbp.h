@@ -13,22 +13,84 @@
 /*-----------------------------------------------------------------
                               Includes
   -----------------------------------------------------------------*/
+#include <stdbool.h>
 #include <stdint.h>
+#include "formula.h"
+
+/*-----------------------------------------------------------------
+                            Definitions
+  -----------------------------------------------------------------*/
+#define PRECISION 10    // Default Number of Digits after Starting Position
+#define MAX_DIGITS 16   // Most Hex Digits a Result Holds (64-Bit Mantissa)
+#define BATCH_SIZE 100  // Default Elements Each Thread Works Per Iteration
 
 /*-----------------------------------------------------------------
                           Structs and Enums
   -----------------------------------------------------------------*/
+#define FORMULA_ID(ID, ...) ID,
+
+// Built-in Formulas, Registered Formulas Use Their Registry Index
 typedef enum {
-	BBP_ORIGINAL,
-	BELLARD  
+	BUILTIN_FORMULAS(FORMULA_ID)
+	TOTAL_BUILTIN
 }Algorithm;
 
+// Format of Result Printed by calcBBP
+typedef enum {
+	REPORT_TEXT,
+	REPORT_JSON,
+	REPORT_CSV
+}ReportFormat;
+
+// Left Summation Kernel of a Computation
+typedef enum {
+	KERNEL_AUTO,     // Specialized Kernel, 128-Bit Only When Offset Needs it
+	KERNEL_GENERIC,  // Formula Read at Run Time (No Specialization)
+	KERNEL_WIDE,     // 128-Bit Arithmetic at Every Offset
+	TOTAL_KERNELS
+}KernelMode;
+
+// Placement of Worker Threads
+typedef enum {
+	PIN_NONE,        // Threads Placed by The OS
+	PIN_CORES,       // One Thread Per Physical Core (Skip SMT Siblings)
+	PIN_CPUS,        // One Thread Per Logical CPU, Cores Before Siblings
+	TOTAL_PINNINGS
+}PinPolicy;
+
+// How Workers Share The Batches
+typedef enum {
+	SCHED_WEIGHTED,  // Shared Counter, Faster Workers Take Several Batches
+	SCHED_EQUAL,     // Shared Counter, One Batch at a Time
+	SCHED_STATIC,    // Batches Interleaved by Worker Index, no Counter
+	TOTAL_SCHEDULERS
+}SchedulerMode;
+
+// Zero Values Are The Defaults of Every Field But startPos and nthreads
 typedef struct {
 	uint64_t startPos;
 	uint16_t nthreads;
 	Algorithm algo;
+	ReportFormat report;
+	uint8_t digits;       // Hex Digits Wanted (0 = Default, Max MAX_DIGITS)
+	PinPolicy pinning;
+	uint64_t batchSize;   // Elements Per Batch (0 = BATCH_SIZE)
+	KernelMode kernel;
+	SchedulerMode scheduler;
 } Config;
 
+// Measurements of a Single Computation
+typedef struct {
+	uint64_t batchSize;   // Elements Each Thread Worked Per Iteration
+	uint64_t terms;       // Terms Evaluated by The Left Summation
+	double leftTime;      // Seconds in Left Summation (Threads)
+	double rightTime;     // Seconds in Right Summation
+	double totalTime;     // Seconds in Whole Computation
+	double queueTime;     // Seconds Waiting For a Worker (Async Jobs)
+	long double errorBound; // Bound on Absolute Error of The Result
+	int guaranteedDigits; // Leading Hex Digits Within The Bound (Max MAX_DIGITS)
+} BBPStats;
+
 
 /*-----------------------------------------------------------------
                   External Functions Declarations
@@ -36,10 +98,125 @@ typedef struct {
 
 /*-----------------------------------------------------------------*/
 /**
-   @brief Execute BBP Formula.
-   @param Config* Pointer to Configuration Struct.
+   @brief  Execute BBP Formula Without Printing Anything. Safe to be
+           Called From Multiple Threads at Once.
+   @param  Config*     Pointer to Configuration Struct.
+   @param  BBPStats*   Measurements of The Run (May be NULL).
+   @return long double Result (Fractional Part Holds The Digits) /
+                       NAN if Algorithm is Invalid.
+*/
+/*-----------------------------------------------------------------*/
+long double evalBBP(Config*, BBPStats*);
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Execute BBP Formula and Print The Result as Text, a JSON
+           Object or a CSV Record (See Config Report).
+   @param  Config* Pointer to Configuration Struct.
+   @return int     Error(1) /Success(0) Code in Operation.
+*/
+/*-----------------------------------------------------------------*/
+int calcBBP(Config*);
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Name of a Kernel Mode ("auto", "generic", "wide").
+   @param  KernelMode  Kernel Mode.
+   @return const char* Name / NULL if Mode is Invalid.
+*/
+/*-----------------------------------------------------------------*/
+const char* kernelName(KernelMode);
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Name of a Pinning Policy ("none", "cores", "cpus").
+   @param  PinPolicy   Pinning Policy.
+   @return const char* Name / NULL if Policy is Invalid.
+*/
+/*-----------------------------------------------------------------*/
+const char* pinningName(PinPolicy);
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Name of a Scheduler ("weighted", "equal", "static").
+   @param  SchedulerMode Scheduler.
+   @return const char*   Name / NULL if Scheduler is Invalid.
+*/
+/*-----------------------------------------------------------------*/
+const char* schedulerName(SchedulerMode);
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Parse a Kernel Mode Name.
+   @param  const char*  Name ("auto", "generic", "wide").
+   @param  KernelMode*  Kernel Mode Parsed.
+   @return int          Error(1) /Success(0) Code in Operation.
+*/
+/*-----------------------------------------------------------------*/
+int parseKernel(const char*, KernelMode*);
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Parse a Pinning Policy Name.
+   @param  const char* Name ("none", "cores", "cpus").
+   @param  PinPolicy*  Pinning Policy Parsed.
+   @return int         Error(1) /Success(0) Code in Operation.
+*/
+/*-----------------------------------------------------------------*/
+int parsePinning(const char*, PinPolicy*);
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Parse a Scheduler Name.
+   @param  const char*    Name ("weighted", "equal", "static").
+   @param  SchedulerMode* Scheduler Parsed.
+   @return int            Error(1) /Success(0) Code in Operation.
+*/
+/*-----------------------------------------------------------------*/
+int parseScheduler(const char*, SchedulerMode*);
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Implement Barret Reduction Algorithm.
+   @param  __uint128_t a*b Calculate in modMul Function.
+   @param  uint64_t    Base of Current Operation.
+   @param  uint64_t    Factor Used For Reduction.
+   @return uint64_t    n mod base.
+*/
+/*-----------------------------------------------------------------*/
+uint64_t barretReduction(__uint128_t, uint64_t, uint64_t);
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Implements a Modular Multiplication.
+   @param  uint64_t Number to Be Multiplied (a).
+   @param  uint64_t Number to Be Multiplied (b).
+   @param  uint64_t    Base of Current Operation.
+   @param  uint64_t    Factor Used For Reduction.
+   @return uint64_t    a*b mod base.
+*/
+/*-----------------------------------------------------------------*/
+uint64_t modMul(uint64_t, uint64_t, uint64_t, uint64_t);
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Implements Barrett Modular Exponentiation Algorithm.
+   @param  uint64_t Number (n).
+   @param  uint64_t Exponent (exp).
+   @param  uint64_t Base of Current Operation.
+   @return uint64_t n^exp mod base.
 */
 /*-----------------------------------------------------------------*/
-void calcBBP(Config*);
+uint64_t modPowBarret(uint64_t, uint64_t, uint64_t);
 
 #endif
@@ -0,0 +1,36 @@
+/*-----------------------------------------------------------------*/
+/**
+
+  @file   bench.h
+  @author Flávio M.
+
+ */
+/*-----------------------------------------------------------------*/
+
+#ifndef BENCH_HEADER_FILE
+#define BENCH_HEADER_FILE
+
+/*-----------------------------------------------------------------
+                              Includes
+  -----------------------------------------------------------------*/
+#include "bbp.h"
+
+
+/*-----------------------------------------------------------------
+                  External Functions Declarations
+  -----------------------------------------------------------------*/
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Microbenchmark of The Modular Primitives (barretReduction,
+           modMul, modPowBarret, modPow2Mont, modPow2Wide) With
+           Moduli of The Sizes Used at Offsets 10^6 to 10^12. Each
+           Primitive is Measured as a Single Dependent Chain (Latency)
+           and as Independent Chains (Throughput), Reporting ns/op and
+           Millions of Ops/s.
+   @param  ReportFormat Format of Results (Text Table, JSON, CSV).
+*/
+/*-----------------------------------------------------------------*/
+void runBench(ReportFormat);
+
+#endif
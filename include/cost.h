@@ -0,0 +1,69 @@
+/*-----------------------------------------------------------------*/
+/**
+
+  @file   cost.h
+  @author Flávio M.
+
+ */
+/*-----------------------------------------------------------------*/
+
+#ifndef COST_HEADER_FILE
+#define COST_HEADER_FILE
+
+/*-----------------------------------------------------------------
+                              Includes
+  -----------------------------------------------------------------*/
+#include <stdint.h>
+#include "bbp.h"
+
+
+/*-----------------------------------------------------------------
+                          Structs and Enums
+  -----------------------------------------------------------------*/
+
+// Predicted Cost of a Computation
+typedef struct {
+	double wallTime;      // Seconds Until The Result
+	double cpuTime;       // CPU-Seconds of Every Thread
+	double leftTime;      // CPU-Seconds of Left Summation
+	double rightTime;     // Seconds of Right Summation
+	double threadTime;    // Seconds Creating and Joining Threads
+	uint64_t terms;       // Terms Evaluated by The Left Summation
+	uint64_t batchSize;   // Elements Each Thread Works Per Iteration
+	uint16_t parallel;    // Threads Actually Running at Once
+} CostEstimate;
+
+
+/*-----------------------------------------------------------------
+                  External Functions Declarations
+  -----------------------------------------------------------------*/
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Fit The Cost Model of an Algorithm From Short Probes on
+           This Host (Done Once, Later Calls Return at Once). Probes
+           Time Single Batches at Chosen Offsets and Positions, and
+           Fit Seconds Per Term = a + b * log2(Exponent) For Each
+           Modular Path (Barrett, 64-Bit and 128-Bit Montgomery).
+   @param  int Algorithm Index.
+   @return int Error(1) /Success(0) Code in Operation.
+*/
+/*-----------------------------------------------------------------*/
+int calibrateCost(int);
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Predict Wall Time and CPU-Seconds of a Computation,
+           Calibrating its Algorithm First if Needed. Left Summation
+           Cost Integrates The Fitted Model Over Every Term, Which
+           Gives The O(d log d) Growth.
+   @param  const Config* Algorithm, Offset and Threads.
+   @param  uint64_t      Batch Size (0 = Default).
+   @param  CostEstimate* Prediction.
+   @return int           Error(1) /Success(0) Code in Operation.
+*/
+/*-----------------------------------------------------------------*/
+int estimateCost(const Config*, uint64_t, CostEstimate*);
+
+#endif
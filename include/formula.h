@@ -0,0 +1,203 @@
+/*-----------------------------------------------------------------*/
+/**
+
+  @file   formula.h
+  @author Flávio M.
+
+ */
+/*-----------------------------------------------------------------*/
+
+#ifndef FORMULA_HEADER_FILE
+#define FORMULA_HEADER_FILE
+
+/*-----------------------------------------------------------------
+                              Includes
+  -----------------------------------------------------------------*/
+#include <stdint.h>
+
+
+/*-----------------------------------------------------------------
+                            Definitions
+  -----------------------------------------------------------------*/
+#define MAX_TERMS 16          // Max Terms in a Formula
+#define MAX_SIGNS 8           // Max Period of a Sign Pattern
+#define MAX_FORMULAS 32       // Max Formulas in The Registry
+#define FORMULA_KEY_SIZE 32   // Max Size of a Formula Key
+#define FORMULA_DESC_SIZE 64  // Max Size of a Formula Description
+
+
+/*-----------------------------------------------------------------
+                          Formula Tables
+  -----------------------------------------------------------------*/
+
+/*
+  Every Formula is Described as a Table of TERM(m, j, l, coef)
+  Entries, Each One Representing:
+
+      coef * 2^(4d + l - shift*k) / (m*k + j)^power
+
+  Where 2^shift is The Base of The Formula and d The Starting
+  Position (Hex Digits). Constant Factors of The Formula Are Folded
+  Into l (Powers of Two) and coef.
+*/
+
+// Original BBP Formula, 16^-k
+#define BBP_ORIGINAL_TERMS(TERM) \
+	TERM(8, 1, 0,  4)            \
+	TERM(8, 4, 0, -2)            \
+	TERM(8, 5, 0, -1)            \
+	TERM(8, 6, 0, -1)
+
+// Bellard Formula, (-1)^k * 2^-10k, 2^-6 Factor in l
+#define BELLARD_TERMS(TERM)      \
+	TERM(4,  1, -1, -1)          \
+	TERM(4,  3, -6, -1)          \
+	TERM(10, 1,  2,  1)          \
+	TERM(10, 3,  0, -1)          \
+	TERM(10, 5, -4, -1)          \
+	TERM(10, 7, -4, -1)          \
+	TERM(10, 9, -6,  1)
+
+// Adamchik-Wagon Formula For Pi, (-1)^k * 4^-k
+#define ADAMCHIK_WAGON_TERMS(TERM) \
+	TERM(4, 1, 1, 1)               \
+	TERM(4, 2, 1, 1)               \
+	TERM(4, 3, 0, 1)
+
+// log(2) = sum 1 / ((k + 1) * 2^(k + 1))
+#define LOG_TWO_TERMS(TERM)      \
+	TERM(1, 1, -1, 1)
+
+// Pi^2, 64^-k With Squared Denominators, 9/8 Factor in l and coef
+#define PI_SQUARED_TERMS(TERM)   \
+	TERM(6, 1, -3,  144)         \
+	TERM(6, 2, -3, -216)         \
+	TERM(6, 3, -3,  -72)         \
+	TERM(6, 4, -3,  -54)         \
+	TERM(6, 5, -3,    9)
+
+
+/*
+  Built-in Formulas, Each Entry is:
+
+  FORMULA(ID, NAME, KEY, DESCRIPTION, SHIFT, POW_BITS, SIGNS, POWER, TERMS)
+
+  ID       -> Algorithm Enum Value.
+  NAME     -> Prefix For The Kernels Generated in bbp.c.
+  KEY      -> Name Used to Select The Formula.
+  POW_BITS -> Bits of Base Used in Modular Exp. Must Divide 4, SHIFT
+              and Every l of The Table.
+  SIGNS    -> Sign Pattern, Repeated Over k ("+-" = (-1)^k).
+
+  Adding a Formula Here Generates its Specialized Kernels and
+  Registers It, No Other Code is Needed.
+*/
+#define BUILTIN_FORMULAS(FORMULA)                                      \
+	FORMULA(BBP_ORIGINAL, bbpAlgoOriginal, "original",                 \
+	        "Original (4-Terms)", 4, 4, "+", 1, BBP_ORIGINAL_TERMS)    \
+	FORMULA(BELLARD, bellard, "bellard",                               \
+	        "Bellard (7-Term)", 10, 1, "+-", 1, BELLARD_TERMS)         \
+	FORMULA(ADAMCHIK_WAGON, adamchikWagon, "adamchik",                 \
+	        "Adamchik-Wagon (3-Term)", 2, 1, "+-", 1,                  \
+	        ADAMCHIK_WAGON_TERMS)                                      \
+	FORMULA(LOG_TWO, logTwo, "log2",                                   \
+	        "log(2) (1-Term)", 1, 1, "+", 1, LOG_TWO_TERMS)            \
+	FORMULA(PI_SQUARED, piSquared, "pi2",                              \
+	        "Pi^2 (5-Term)", 6, 1, "+", 2, PI_SQUARED_TERMS)
+
+
+/*-----------------------------------------------------------------
+                          Structs and Enums
+  -----------------------------------------------------------------*/
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief Term of a Formula, coef * 2^(4d + l - shift*k) / (m*k + j).
+*/
+/*-----------------------------------------------------------------*/
+typedef struct {
+	int m;
+	int j;
+	int l;
+	int coef;
+} Term;
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief BBP-Type Formula Description.
+*/
+/*-----------------------------------------------------------------*/
+typedef struct {
+	char key[FORMULA_KEY_SIZE];          // Name Used to Select The Formula
+	char description[FORMULA_DESC_SIZE]; // Text Shown to User
+	int shift;                           // Base of The Formula is 2^shift
+	int powBits;                         // Bits of Base Used in Modular Exp
+	int power;                           // Power of Denominators
+	char signs[MAX_SIGNS + 1];           // Sign Pattern, Repeated Over k
+	uint16_t totalTerms;                 // Terms in Use
+	Term terms[MAX_TERMS];               // Terms of The Formula
+} Formula;
+
+
+/*-----------------------------------------------------------------
+                  External Functions Declarations
+  -----------------------------------------------------------------*/
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Get a Formula From The Registry.
+   @param  int            Index of Formula (Algorithm Value).
+   @return const Formula* Formula / NULL if Index is Invalid.
+*/
+/*-----------------------------------------------------------------*/
+const Formula* getFormula(int);
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Search a Formula in The Registry By Its Key.
+   @param  const char* Key of Formula.
+   @return int         Index of Formula / -1 if Not Found.
+*/
+/*-----------------------------------------------------------------*/
+int findFormula(const char*);
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Total Formulas in The Registry.
+   @return uint16_t Number of Formulas.
+*/
+/*-----------------------------------------------------------------*/
+uint16_t totalFormulas();
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Validate a Formula and Add it to The Registry. powBits
+           is Calculated Based on The Terms.
+   @param  const Formula* Formula to be Added.
+   @return int            Index of New Formula / -1 on Error.
+*/
+/*-----------------------------------------------------------------*/
+int registerFormula(const Formula*);
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Parse a Formula Description With The Format:
+
+           "key base signs power m,j,l,coef m,j,l,coef ..."
+
+           Example (Original BBP):
+           "bbp 16 + 1 8,1,0,4 8,4,0,-2 8,5,0,-1 8,6,0,-1"
+
+   @param  const char* Formula Description.
+   @param  Formula*    Pointer in Which the Result Be Stored.
+   @return int         Error(1) /Success(0) Code in Operation.
+*/
+/*-----------------------------------------------------------------*/
+int parseFormula(const char*, Formula*);
+
+#endif
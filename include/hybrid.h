@@ -0,0 +1,79 @@
+/*-----------------------------------------------------------------*/
+/**
+
+  @file   hybrid.h
+  @author Flávio M.
+
+ */
+/*-----------------------------------------------------------------*/
+
+#ifndef HYBRID_HEADER_FILE
+#define HYBRID_HEADER_FILE
+
+/*-----------------------------------------------------------------
+                              Includes
+  -----------------------------------------------------------------*/
+#include <stdint.h>
+#include "bbp.h"
+
+
+/*-----------------------------------------------------------------
+                            Definitions
+  -----------------------------------------------------------------*/
+#define HYBRID_DIGITS 10   // Hex Digits Cross-Checked (as Printed by calcBBP)
+
+
+/*-----------------------------------------------------------------
+                          Structs and Enums
+  -----------------------------------------------------------------*/
+
+typedef enum {
+	HYBRID_VERIFY,     // Wait For Both Formulas, Cross-Check Their Digits
+	HYBRID_FIRST       // Return The First Result, Stop The Other Formula
+}HybridMode;
+
+// Outcome of a Hybrid Run, Sides Indexed 0 = Original, 1 = Bellard
+typedef struct {
+	long double result;    // Result of The First Formula to Finish
+	Algorithm first;       // Formula That Finished First
+	uint16_t threads[2];   // Threads Given to Each Formula
+	double times[2];       // Seconds Until Each Finished (< 0 = Stopped)
+	long double values[2]; // Result of Each Formula (NAN = Stopped)
+	int matching;          // Leading Hex Digits Both Agree On (-1 = Not Checked)
+} HybridResult;
+
+
+/*-----------------------------------------------------------------
+                  External Functions Declarations
+  -----------------------------------------------------------------*/
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Run The Original and Bellard Formulas at Once at The Same
+           Offset, Splitting The Config Threads in Proportion to The
+           Terms of Their Left Summations, so Both End Together. With
+           a Single Thread They Run One After The Other, Cheaper
+           First (Only it in HYBRID_FIRST Mode). With Pinning, One
+           List of CPUs is Split, so The Formulas Never Share a CPU
+           (Unless Threads Outnumber CPUs).
+   @param  const Config* Offset and Threads (Algorithm is Ignored).
+   @param  HybridMode    Cross-Check Both / Return The First.
+   @param  HybridResult* Results, Split and Agreement.
+   @return int           Error(1) /Success(0) Code in Operation.
+*/
+/*-----------------------------------------------------------------*/
+int evalHybrid(const Config*, HybridMode, HybridResult*);
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Execute a Hybrid Run and Print Both Formulas, Their Split
+           and Whether The Digits Agree.
+   @param  Config*    Offset and Threads (Algorithm is Ignored).
+   @param  HybridMode Cross-Check Both / Return The First.
+   @return int        Error or Disagreement(1) /Success(0) Code.
+*/
+/*-----------------------------------------------------------------*/
+int calcHybrid(Config*, HybridMode);
+
+#endif
@@ -0,0 +1,190 @@
+/*-----------------------------------------------------------------*/
+/**
+
+  @file   job.h
+  @author Flávio M.
+
+ */
+/*-----------------------------------------------------------------*/
+
+#ifndef JOB_HEADER_FILE
+#define JOB_HEADER_FILE
+
+/*-----------------------------------------------------------------
+                              Includes
+  -----------------------------------------------------------------*/
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include "bbp.h"
+#include "formula.h"
+
+
+/*-----------------------------------------------------------------
+                            Definitions
+  -----------------------------------------------------------------*/
+#define ACC_ALIGN 128    // Accumulator Alignment (Pair of Cache Lines)
+#define FAST_BITS 32     // Moduli Below 2^FAST_BITS Use Barrett Reduction
+#define MAX_WEIGHT 8     // Most Batches a Worker Takes at Once
+
+
+/*-----------------------------------------------------------------
+                          Structs and Enums
+  -----------------------------------------------------------------*/
+
+typedef struct bbpJob BBPJob;
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief Accumulator of a Single Worker. Each Slot Fills Whole
+          Cache Lines (Two, as Adjacent Lines Are Prefetched
+          Together), so Workers Never Write to a Shared Line.
+*/
+/*-----------------------------------------------------------------*/
+typedef struct {
+	_Alignas(ACC_ALIGN) __uint128_t sum; // Left Summation of Worker Batches (Fixed Point)
+	BBPJob* job;                         // Job of Worker
+	int cpu;                             // CPU Worker is Pinned to (-1 = Any)
+	uint32_t weight;                     // Batches Taken at Once Until Measured
+	double batchTime;                    // Seconds Per Batch (Guarded by The Count Lock)
+	uint64_t next;                       // Next Batch of a Pool Worker (Static Scheduler)
+} WorkerSlot;
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief Summation Functions Used For a Formula.
+*/
+/*-----------------------------------------------------------------*/
+typedef struct {
+	long double (*left) (const BBPJob*, uint64_t); // Left Summation From k to k + batchSize
+	long double (*right) (const BBPJob*);          // Right Summation
+	uint64_t (*bound) (const BBPJob*);             // Largest Upper Bound of The Terms
+} Kernels;
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief State of a Single Computation, Shared by its Threads.
+*/
+/*-----------------------------------------------------------------*/
+typedef struct bbpJob {
+	const Formula* formula;         // Formula of Algorithm in Use
+	Kernels kernels;                // Summation Functions of Formula
+	uint64_t d;                     // Starting Position
+	uint64_t termBounds[MAX_TERMS]; // Upper Bounds For Each Term
+	uint64_t upperBound;            // Largest Upper Bound
+	uint64_t batchSize;             // Elements Each Thread Works Per Iteration
+	uint16_t activeThreads;         // Threads Used
+	int digits;                     // Hex Digits Wanted, Sets Right Summation Length
+	bool wide;                      // Left Summation Uses 128-Bit Kernel
+	PinPolicy pinning;              // Placement of Workers
+	const WorkerSlot* places;       // CPUs and Weights Chosen by The Caller (NULL = By pinning)
+	SchedulerMode scheduler;        // How Workers Share The Batches
+
+	pthread_mutex_t counterMutex;
+	uint64_t count;
+	atomic_bool stop;               // Workers Take No More Batches (Result Discarded)
+	WorkerSlot* slots;              // One Accumulator Per Thread
+} BBPJob;
+
+
+/*-----------------------------------------------------------------
+                  External Functions Declarations
+  -----------------------------------------------------------------*/
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Config Job Variables and Functions for The Algorithm
+           Selected.
+   @param  BBPJob* Job to be Initialized.
+   @param  Config* Pointer to Configuration Struct.
+   @return int     Error(1) /Success(0) Code in Operation.
+*/
+/*-----------------------------------------------------------------*/
+int initJob(BBPJob*, Config*);
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Execute BBP Algo Starting at d up to n Digits. Setting
+           The Job stop Flag From Another Thread Ends it Early, After
+           The Batches Being Run.
+   @param  BBPJob*     Job Initialized by initJob.
+   @param  BBPStats*   Measurements of The Run (May be NULL).
+   @return long double Fractional Part Containing The Result.
+*/
+/*-----------------------------------------------------------------*/
+long double bbpAlgo(BBPJob*, BBPStats*);
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Rigorous Bound on The Absolute Error of The Result of a
+           Job, Counting Every Rounding of The Kernels (Reciprocals,
+           Products, Partial Sums, Fixed Point Conversions) in The
+           Worst Case, Plus The Right Summation Cut-Off.
+   @param  const BBPJob* Job Initialized by initJob.
+   @return long double   Error Bound.
+*/
+/*-----------------------------------------------------------------*/
+long double errorBound(const BBPJob*);
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Left Summation of a Single Batch, in Fixed Point. Batches
+           Can be Run in Any Order by Any Thread, Their Sum Modulo
+           2^128 is The Left Summation.
+   @param  const BBPJob* Job Initialized by initJob.
+   @param  uint64_t      First k of Batch (Multiple of batchSize).
+   @return __uint128_t   frac(Batch Sum) * 2^128.
+*/
+/*-----------------------------------------------------------------*/
+__uint128_t runBatch(const BBPJob*, uint64_t);
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Batches a Worker Takes at Once. Faster Cores Take More, in
+           Proportion to The CPU-Seconds Per Batch of The Slowest
+           Worker Over Their Own (Static Weight Until Measured), But
+           Never More Than Their Share of The Batches Left, so The
+           Last Ones Still Spread Over Every Worker. Called With
+           The Lock Guarding The Count Held.
+   @param  const BBPJob*     Job Being Run.
+   @param  const WorkerSlot* Slot of Worker.
+   @return uint64_t          Number of Batches (>= 1).
+*/
+/*-----------------------------------------------------------------*/
+uint64_t batchesToTake(const BBPJob*, const WorkerSlot*);
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Pin Workers by a Pinning Policy, Fastest CPUs First,
+           Setting Their Static Weights From Capacities. With One Per
+           Physical Core, More Threads Than Cores Run With One Per
+           Core; With Every CPU, Extra Threads Wrap Around.
+   @param  WorkerSlot* Slots of Workers (cpu = -1, weight = 1).
+   @param  uint16_t    Number of Workers.
+   @param  PinPolicy   Pinning Policy.
+   @return uint16_t    Workers to Run.
+*/
+/*-----------------------------------------------------------------*/
+uint16_t placeWorkers(WorkerSlot*, uint16_t, PinPolicy);
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Add The Right Summation to The Left One.
+   @param  const BBPJob* Job Initialized by initJob.
+   @param  __uint128_t   Sum of Every Batch of The Job.
+   @return long double   Fractional Part Containing The Result.
+*/
+/*-----------------------------------------------------------------*/
+long double finishJob(const BBPJob*, __uint128_t);
+
+#endif
@@ -0,0 +1,106 @@
+/*-----------------------------------------------------------------*/
+/**
+
+  @file   modular.h
+  @author Flávio M.
+
+ */
+/*-----------------------------------------------------------------*/
+
+#ifndef MODULAR_HEADER_FILE
+#define MODULAR_HEADER_FILE
+
+/*-----------------------------------------------------------------
+                              Includes
+  -----------------------------------------------------------------*/
+#include <stdint.h>
+
+
+/*-----------------------------------------------------------------
+                            Definitions
+  -----------------------------------------------------------------*/
+#define MONT_MAX_BITS 63    // Moduli of modPow2Mont Are Below 2^63
+#define WIDE_MAX_BITS 126   // Moduli of modPow2Wide Are Below 2^126
+
+
+/*-----------------------------------------------------------------
+                  External Functions Declarations
+  -----------------------------------------------------------------*/
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Power of Two Modulo a 64-Bit Number With Montgomery
+           Multiplication. Even Moduli (2^t * o) Are Split, Only
+           The Odd Part Goes Through Montgomery.
+   @param  uint64_t Exponent (exp).
+   @param  uint64_t Base of Current Operation (< 2^MONT_MAX_BITS).
+   @return uint64_t 2^exp mod base.
+*/
+/*-----------------------------------------------------------------*/
+uint64_t modPow2Mont(uint64_t, uint64_t);
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  modPow2Mont With The Reciprocal of The Base Supplied (From
+           a Batched Inversion), so No Hardware Divide is Needed.
+   @param  uint64_t    Exponent (exp).
+   @param  uint64_t    Base of Current Operation (< 2^MONT_MAX_BITS).
+   @param  long double Approximate 1 / base (Within a Few ulps).
+   @return uint64_t    2^exp mod base.
+*/
+/*-----------------------------------------------------------------*/
+uint64_t modPow2MontInv(uint64_t, uint64_t, long double);
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Exact Barrett Factor floor((2^64 - 1) / base) From an
+           Approximate Reciprocal, Corrected Without Dividing.
+   @param  uint64_t    Base of Current Operation.
+   @param  long double Approximate 1 / base (Within a Few ulps).
+   @return uint64_t    Barrett Factor.
+*/
+/*-----------------------------------------------------------------*/
+uint64_t barrettFactor(uint64_t, long double);
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Reciprocals of a Small Batch With a Single Divide
+           (Montgomery's Simultaneous Inversion): Prefix Products,
+           One Inverse, Then Back Substitution. Error Grows With The
+           Batch Size, About 2 * size ulps.
+   @param  const long double* Numbers (Nonzero).
+   @param  long double*       Reciprocals.
+   @param  int                Size of Batch (>= 1).
+*/
+/*-----------------------------------------------------------------*/
+void batchInverse(const long double*, long double*, int);
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Power of Two Modulo a 128-Bit Number With 128-Bit
+           Montgomery Multiplication (256-Bit Products).
+   @param  __uint128_t Exponent (exp).
+   @param  __uint128_t Base of Current Operation (< 2^WIDE_MAX_BITS).
+   @return __uint128_t 2^exp mod base.
+*/
+/*-----------------------------------------------------------------*/
+__uint128_t modPow2Wide(__uint128_t, __uint128_t);
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Modular Multiplication of 128-Bit Numbers by Shifts and
+           Adds. Slow, Used as Reference For The Montgomery Paths.
+   @param  __uint128_t Number to Be Multiplied (a).
+   @param  __uint128_t Number to Be Multiplied (b).
+   @param  __uint128_t Base of Current Operation (< 2^127).
+   @return __uint128_t a*b mod base.
+*/
+/*-----------------------------------------------------------------*/
+__uint128_t mulModSlow(__uint128_t, __uint128_t, __uint128_t);
+
+#endif
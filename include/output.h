@@ -0,0 +1,111 @@
+/*-----------------------------------------------------------------*/
+/**
+
+  @file   output.h
+  @author Flávio M.
+
+ */
+/*-----------------------------------------------------------------*/
+
+#ifndef OUTPUT_HEADER_FILE
+#define OUTPUT_HEADER_FILE
+
+/*-----------------------------------------------------------------
+                              Includes
+  -----------------------------------------------------------------*/
+#include <stddef.h>
+#include <stdint.h>
+
+
+/*-----------------------------------------------------------------
+                            Definitions
+  -----------------------------------------------------------------*/
+#define FRACTION_BYTES 8   // Max Bytes Extracted From a Fraction
+
+
+/*-----------------------------------------------------------------
+                          Structs and Enums
+  -----------------------------------------------------------------*/
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief Formats For Extracted Digits.
+*/
+/*-----------------------------------------------------------------*/
+typedef enum {
+	DIGITS_HEX, // Base 16 String
+	DIGITS_BIN, // Base 2 String
+	DIGITS_OCT, // Base 8 String
+	DIGITS_RAW  // Packed Bytes, Most Significant First
+} DigitFormat;
+
+
+/*-----------------------------------------------------------------
+                  External Functions Declarations
+  -----------------------------------------------------------------*/
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Pack The Fractional Part of a Number Into Bytes, Most
+           Significant First. Negative Numbers Are Reduced to [0, 1).
+   @param  long double Number Returned by The BBP Algo.
+   @param  uint8_t*    Buffer in Which The Bytes Will Be Stored.
+   @param  size_t      Bytes to Extract (Max FRACTION_BYTES).
+   @return size_t      Bytes Written.
+*/
+/*-----------------------------------------------------------------*/
+size_t packFraction(long double, uint8_t*, size_t);
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Leading Hex Digits That Are Certain Given an Error Bound:
+           Every Number Within The Bound Has Them.
+   @param  long double Number Returned by The BBP Algo.
+   @param  long double Bound on its Absolute Error.
+   @param  int         Max Digits Counted.
+   @return int         Guaranteed Digits.
+*/
+/*-----------------------------------------------------------------*/
+int guaranteedDigits(long double, long double, int);
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Format Packed Bits Into a Caller Buffer. Strings Are Null
+           Terminated, Raw Output is Not. Octal Uses Only Complete
+           Groups of 3 Bits.
+   @param  const uint8_t* Packed Bytes, Most Significant First.
+   @param  size_t         Number of Bits to Format.
+   @param  DigitFormat    Output Format.
+   @param  char*          Output Buffer.
+   @param  size_t         Size of Output Buffer.
+   @return size_t         Chars/Bytes Written (Without Null) / 0 If
+                          Buffer is Too Small.
+*/
+/*-----------------------------------------------------------------*/
+size_t formatDigits(const uint8_t*, size_t, DigitFormat, char*, size_t);
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Size Needed to Format a Number of Bits (With Null).
+   @param  size_t      Number of Bits.
+   @param  DigitFormat Output Format.
+   @return size_t      Size in Bytes.
+*/
+/*-----------------------------------------------------------------*/
+size_t formattedSize(size_t, DigitFormat);
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Parse The Name of a Format (hex, bin, oct, raw).
+   @param  const char*  Name of Format.
+   @param  DigitFormat* Parsed Format.
+   @return int          Error(1) /Success(0) Code in Operation.
+*/
+/*-----------------------------------------------------------------*/
+int parseDigitFormat(const char*, DigitFormat*);
+
+#endif
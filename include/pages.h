@@ -28,4 +28,13 @@
 /*-----------------------------------------------------------------*/
 MenuSt* initPages();
 
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief Cancel Background Jobs of The Menu and Free it.
+   @param MenuSt* Pointer to Menu.
+*/
+/*-----------------------------------------------------------------*/
+void freePages(MenuSt*);
+
 #endif
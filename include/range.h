@@ -0,0 +1,43 @@
+/*-----------------------------------------------------------------*/
+/**
+
+  @file   range.h
+  @author Flávio M.
+
+ */
+/*-----------------------------------------------------------------*/
+
+#ifndef RANGE_HEADER_FILE
+#define RANGE_HEADER_FILE
+
+/*-----------------------------------------------------------------
+                              Includes
+  -----------------------------------------------------------------*/
+#include <stdint.h>
+#include "bbp.h"
+#include "output.h"
+
+
+/*-----------------------------------------------------------------
+                  External Functions Declarations
+  -----------------------------------------------------------------*/
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Extract a Range of Hex Digits Into a Preallocated,
+           Memory-Mapped File. The Range is Split in Fixed Windows,
+           Each One Written by its Worker Straight Into its Own
+           Position of The File. Finished Windows Are Marked in a
+           "<file>.done" Map, So an Interrupted Run Resumes Where it
+           Stopped When Called Again With The Same Arguments.
+   @param  Config*     Configuration (startPos = First Digit,
+                       nthreads = Workers).
+   @param  uint64_t    Number of Hex Digits to Extract.
+   @param  DigitFormat Format of Output File.
+   @param  const char* Path of Output File.
+   @return int         Error(1) /Success(0) Code in Operation.
+*/
+/*-----------------------------------------------------------------*/
+int calcRange(Config*, uint64_t, DigitFormat, const char*);
+
+#endif
@@ -0,0 +1,70 @@
+/*-----------------------------------------------------------------*/
+/**
+
+  @file   repeat.h
+  @author Flávio M.
+
+ */
+/*-----------------------------------------------------------------*/
+
+#ifndef REPEAT_HEADER_FILE
+#define REPEAT_HEADER_FILE
+
+/*-----------------------------------------------------------------
+                              Includes
+  -----------------------------------------------------------------*/
+#include <stdint.h>
+#include "bbp.h"
+
+
+/*-----------------------------------------------------------------
+                          Structs and Enums
+  -----------------------------------------------------------------*/
+
+// Distribution of The Times of Repeated Computations
+typedef struct {
+	uint32_t runs;        // Runs Timed
+	uint32_t warmup;      // Runs Done Before, Not Timed
+	double min;           // Seconds of Fastest Run
+	double median;
+	double p90;           // 90th Percentile (Nearest Rank)
+	double mean;
+	double stddev;        // Sample Standard Deviation (0 For One Run)
+	double termsPerSec;   // Terms of a Run Over Median Time
+	double digitsPerSec;  // Digits of a Run Over Median Time
+} TimingSummary;
+
+
+/*-----------------------------------------------------------------
+                  External Functions Declarations
+  -----------------------------------------------------------------*/
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Summarize Run Times. The Times Are Sorted in Place.
+   @param  double*        Seconds of Each Run.
+   @param  uint32_t       Number of Runs (At Least 1).
+   @param  TimingSummary* Summary (Only Times Filled).
+   @return int            Error(1) /Success(0) Code in Operation.
+*/
+/*-----------------------------------------------------------------*/
+int summarizeTimes(double*, uint32_t, TimingSummary*);
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Run The Same Computation Several Times in Process, After
+           Some Untimed Warm-Up Runs (Page Faults, Clock Ramp-Up,
+           First Thread Creations), and Print The Result With Min,
+           Median, 90th Percentile and Standard Deviation of The
+           Times, Plus Terms and Digits Per Second. Structured
+           Reports Print a Single Record (See printTimingReport).
+   @param  Config*  Configuration of Computation.
+   @param  uint32_t Timed Runs (At Least 1).
+   @param  uint32_t Warm-Up Runs.
+   @return int      Error(1) /Success(0) Code in Operation.
+*/
+/*-----------------------------------------------------------------*/
+int calcRepeated(Config*, uint32_t, uint32_t);
+
+#endif
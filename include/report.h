@@ -0,0 +1,69 @@
+/*-----------------------------------------------------------------*/
+/**
+
+  @file   report.h
+  @author Flávio M.
+
+ */
+/*-----------------------------------------------------------------*/
+
+#ifndef REPORT_HEADER_FILE
+#define REPORT_HEADER_FILE
+
+/*-----------------------------------------------------------------
+                              Includes
+  -----------------------------------------------------------------*/
+#include <stdio.h>
+#include "bbp.h"
+#include "repeat.h"
+
+
+/*-----------------------------------------------------------------
+                  External Functions Declarations
+  -----------------------------------------------------------------*/
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Print a Single Record of a Computation as a JSON Object
+           (One Line) or as a CSV Header Followed by One Row, With
+           Algorithm, Offset, Threads, Batch Size, Digits, Total,
+           Left and Right Times and Terms Per Second.
+   @param  FILE*           Output Stream.
+   @param  const Config*   Configuration of The Computation.
+   @param  const BBPStats* Measurements of The Computation.
+   @param  const char*     Hex Digits Extracted.
+   @return int             Error(1) /Success(0) Code in Operation.
+*/
+/*-----------------------------------------------------------------*/
+int printReport(FILE*, const Config*, const BBPStats*, const char*);
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Print a Single Record of Repeated Computations, Like
+           printReport But With Runs, Warm-Up Runs, Min, Median,
+           90th Percentile, Mean and Standard Deviation of The Times
+           in Place of a Single Run Times, and Digits Per Second.
+   @param  FILE*                Output Stream.
+   @param  const Config*        Configuration of The Computation.
+   @param  const BBPStats*      Measurements of The Last Run.
+   @param  const char*          Hex Digits Extracted.
+   @param  const TimingSummary* Times of Every Timed Run.
+   @return int                  Error(1) /Success(0) Code in Operation.
+*/
+/*-----------------------------------------------------------------*/
+int printTimingReport(FILE*, const Config*, const BBPStats*, const char*,
+                      const TimingSummary*);
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Parse The Name of a Report Format (text, json, csv).
+   @param  const char*   Name of Format.
+   @param  ReportFormat* Parsed Format.
+   @return int           Error(1) /Success(0) Code in Operation.
+*/
+/*-----------------------------------------------------------------*/
+int parseReportFormat(const char*, ReportFormat*);
+
+#endif
@@ -0,0 +1,60 @@
+/*-----------------------------------------------------------------*/
+/**
+
+  @file   server.h
+  @author Flávio M.
+
+ */
+/*-----------------------------------------------------------------*/
+
+#ifndef SERVER_HEADER_FILE
+#define SERVER_HEADER_FILE
+
+/*-----------------------------------------------------------------
+                              Includes
+  -----------------------------------------------------------------*/
+#include <stdint.h>
+
+
+/*-----------------------------------------------------------------
+                            Definitions
+  -----------------------------------------------------------------*/
+#define DEFAULT_SOCKET "/tmp/pi-bbp.sock"
+
+
+/*-----------------------------------------------------------------
+                  External Functions Declarations
+  -----------------------------------------------------------------*/
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Serve Digits Over a Unix Domain Socket Until a SHUTDOWN
+           Request. One Request Per Line, One Response Per Line:
+             "<algorithm> <offset> [digits]" -> "OK <hex digits>"
+             "STATS"    -> "OK requests=.. hits=.. p50=..us ... queue=..us"
+             "SHUTDOWN" -> "OK"
+           Errors Are Answered With "ERR <message>". Digits Are
+           Computed in Aligned Windows on a Warm Worker Pool, Kept in
+           a Result Cache, and Windows Wanted by Concurrent Requests
+           Are Computed Once.
+   @param  const char* Path of Socket.
+   @param  uint16_t    Number of Pool Workers.
+   @return int         Error(1) /Success(0) Code in Operation.
+*/
+/*-----------------------------------------------------------------*/
+int runServer(const char*, uint16_t);
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Send Requests to a Running Server and Print Responses.
+   @param  const char* Path of Socket.
+   @param  const char* Request Line / NULL to Send Every Line of
+                       Standard Input.
+   @return int         Error(1) /Success(0) Code in Operation (Any
+                       "ERR" Response is an Error).
+*/
+/*-----------------------------------------------------------------*/
+int runClient(const char*, const char*);
+
+#endif
@@ -0,0 +1,113 @@
+/*-----------------------------------------------------------------*/
+/**
+
+  @file   topology.h
+  @author Flávio M.
+
+ */
+/*-----------------------------------------------------------------*/
+
+#ifndef TOPOLOGY_HEADER_FILE
+#define TOPOLOGY_HEADER_FILE
+
+/*-----------------------------------------------------------------
+                              Includes
+  -----------------------------------------------------------------*/
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+
+/*-----------------------------------------------------------------
+                            Definitions
+  -----------------------------------------------------------------*/
+#define MAX_CPUS 1024        // Logical CPUs Tracked
+#define MAX_CACHE_LEVELS 4   // Cache Levels Tracked (L1 to L4)
+#define FULL_CAPACITY 1024   // Capacity of The Fastest Core
+
+
+/*-----------------------------------------------------------------
+                          Structs and Enums
+  -----------------------------------------------------------------*/
+
+// Kind of Core, Efficiency Cores Have a Lower Capacity
+typedef enum {
+	CORE_PERFORMANCE,
+	CORE_EFFICIENCY
+}CoreType;
+
+// A Logical CPU The Process May Run On
+typedef struct {
+	int id;               // Logical CPU Number
+	int core;             // Physical Core (Index in Topology)
+	int thread;           // Position Among SMT Siblings (0 = First)
+	CoreType type;
+	uint32_t capacity;    // Relative Throughput (Fastest = FULL_CAPACITY), From
+	                      // cpu_capacity Else cpuinfo_max_freq
+} CpuInfo;
+
+// Logical CPUs of The Machine, as Seen From sysfs
+typedef struct {
+	int total;                            // Logical CPUs
+	int cores;                            // Physical Cores
+	int efficiency;                       // Logical CPUs on Efficiency Cores
+	CpuInfo cpus[MAX_CPUS];
+	uint32_t cacheKb[MAX_CACHE_LEVELS];   // Data Cache Size Per Level (0 = None)
+	int cacheShared[MAX_CACHE_LEVELS];    // Logical CPUs Sharing Each Cache
+} Topology;
+
+
+/*-----------------------------------------------------------------
+                  External Functions Declarations
+  -----------------------------------------------------------------*/
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Topology of The CPUs The Process May Run On, Read Once
+           From sysfs. Capacities Come From cpu_capacity, Else The
+           Maximum Frequency (cpuinfo_max_freq). CPUs in The cpu_atom
+           List of Hybrid x86 Parts, or Well Below The Fastest, Are
+           Efficiency Cores. Without sysfs Every Online CPU is a
+           Performance Core of its Own.
+   @return const Topology* Topology (Never NULL).
+*/
+/*-----------------------------------------------------------------*/
+const Topology* getTopology();
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Choose CPUs For Worker Threads. The Fastest Cores Come
+           First, and Every Core Gets One Thread Before Any SMT
+           Sibling Gets a Second.
+   @param  const Topology* Topology of Machine.
+   @param  bool            Skip SMT Siblings (One CPU Per Core).
+   @param  int*            Chosen CPUs (Logical CPU Numbers).
+   @param  uint32_t*       Capacity of Each Chosen CPU (May be NULL).
+   @param  int             Max CPUs to Choose.
+   @return int             Number of CPUs Chosen.
+*/
+/*-----------------------------------------------------------------*/
+int selectCpus(const Topology*, bool, int*, uint32_t*, int);
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Make Threads Created With an Attribute Run Only on a CPU.
+   @param  pthread_attr_t* Initialized Thread Attribute.
+   @param  int             Logical CPU Number.
+   @return int             Error(1) /Success(0) Code in Operation.
+*/
+/*-----------------------------------------------------------------*/
+int pinAttribute(pthread_attr_t*, int);
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief Print Cores, Their Types, SMT Siblings and Caches.
+   @param const Topology* Topology of Machine.
+*/
+/*-----------------------------------------------------------------*/
+void printTopology(const Topology*);
+
+#endif
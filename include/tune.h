@@ -0,0 +1,37 @@
+/*-----------------------------------------------------------------*/
+/**
+
+  @file   tune.h
+  @author Flávio M.
+
+ */
+/*-----------------------------------------------------------------*/
+
+#ifndef TUNE_HEADER_FILE
+#define TUNE_HEADER_FILE
+
+/*-----------------------------------------------------------------
+                              Includes
+  -----------------------------------------------------------------*/
+#include "bbp.h"
+
+
+/*-----------------------------------------------------------------
+                  External Functions Declarations
+  -----------------------------------------------------------------*/
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Short Sweep Over Threads, Scheduler, Batch Size, Kernel
+           and Pinning, One Setting at a Time Keeping The Best of
+           Those Before. Each Candidate Runs The Config Formula at
+           its Offset (Clamped to Take a Fraction of a Second), and
+           The Median of a Few Runs is Kept. The Fastest Settings
+           Are Printed and Written Back to The Config.
+   @param  Config* Configuration to be Tuned.
+   @return int     Error(1) /Success(0) Code in Operation.
+*/
+/*-----------------------------------------------------------------*/
+int quickBenchmark(Config*);
+
+#endif
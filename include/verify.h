@@ -0,0 +1,39 @@
+/*-----------------------------------------------------------------*/
+/**
+
+  @file   verify.h
+  @author Flávio M.
+
+ */
+/*-----------------------------------------------------------------*/
+
+#ifndef VERIFY_HEADER_FILE
+#define VERIFY_HEADER_FILE
+
+/*-----------------------------------------------------------------
+                              Includes
+  -----------------------------------------------------------------*/
+#include <stdint.h>
+
+
+/*-----------------------------------------------------------------
+                  External Functions Declarations
+  -----------------------------------------------------------------*/
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Self Check of The Engine. Compares Every Formula Against
+           Known Digits at Many Offsets (Including Offsets Where
+           The Upper Bound is Smaller Than a Batch or Zero), Compares
+           modPowBarret Against a Reference Modular Exponentiation
+           and Measures Terms Per Second of a Reference Run.
+   @param  uint16_t Number of Threads Used in Digit Checks.
+   @param  double   Expected Terms Per Second of Reference Run, Fails
+                    If Measured Value is More Than PERF_TOLERANCE
+                    Below it (0 = No Performance Guard).
+   @return int      Number of Failed Checks (0 = Success).
+*/
+/*-----------------------------------------------------------------*/
+int runVerify(uint16_t, double);
+
+#endif
@@ -0,0 +1,688 @@
+/*-----------------------------------------------------------------*/
+/**
+  @file   async.c
+  @author Flávio M.
+  @brief  Asynchronous Jobs Over a Shared Worker Pool.
+ */
+/*-----------------------------------------------------------------*/
+
+/*-----------------------------------------------------------------
+                              Includes
+  -----------------------------------------------------------------*/
+#include <math.h>
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "../include/async.h"
+#include "../include/bbp.h"
+#include "../include/error-handler.h"
+#include "../include/job.h"
+#include "../include/output.h"
+#include "../include/topology.h"
+
+
+/*-----------------------------------------------------------------
+                            Definitions
+-----------------------------------------------------------------*/
+#define AGING_SECONDS 0.05     // Weight of a Waiting Job Doubles Every Period
+#define BATCH_EWMA 0.25        // Weight of Newest Batch in Time Estimate
+
+
+/*-----------------------------------------------------------------
+                          Structs and Enums
+-----------------------------------------------------------------*/
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief State of a Submitted Job. Guarded by The Pool Mutex,
+          Except Slots (Each Written Only by its Worker).
+*/
+/*-----------------------------------------------------------------*/
+struct bbpFuture {
+	BBPJob job;               // Engine State
+	WorkerSlot* slots;        // One Accumulator Per Pool Worker
+	BBPCallback callback;
+	void* userData;
+
+	FutureState state;
+	long double result;
+	uint32_t inFlight;        // Batches Being Run
+	bool cancelled;           // No More Batches Will be Taken
+	bool finishing;           // Last Batch Ended, Being Settled
+	bool settled;             // Callback Returned, Safe to Free
+	pthread_cond_t settledCond;
+
+	int priority;
+	double deadline;          // Absolute (now()), 0 = None
+	double submitTime;
+	double startTime;         // First Batch Taken, 0 = Not Yet
+	double lastServed;        // Last Batch Taken (Aging)
+	double leftEnd;           // Last Batch Ended
+	double settleTime;
+
+	bool queued;              // Still Has Batches to Hand Out
+	BBPFuture* next;          // Next Job in Pool Queue
+};
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief Worker Pool. Jobs With Batches Left Are Kept in a List,
+          Scanned For The Most Urgent One on Every Batch. Jobs Keep
+          The Pinning of The Pool, But Take Batches by Their Own
+          Scheduler.
+*/
+/*-----------------------------------------------------------------*/
+typedef struct {
+	pthread_mutex_t mutex;
+	pthread_cond_t work;
+	pthread_t* workers;
+	WorkerSlot* places;       // Placement and Weight of Each Worker
+	uint16_t totalWorkers;
+	bool running;
+	BBPFuture* head;
+	double batchTime;         // Average Seconds Per Batch (All Jobs)
+} Pool;
+
+
+/*-----------------------------------------------------------------
+                          Global Variables
+-----------------------------------------------------------------*/
+static Pool pool = {
+	.mutex = PTHREAD_MUTEX_INITIALIZER,
+	.work = PTHREAD_COND_INITIALIZER
+};
+
+
+/*-----------------------------------------------------------------
+                   Internal Functions Signatures
+  -----------------------------------------------------------------*/
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Pool Worker. Takes One Batch at a Time From The Job at
+           The Head of The Queue.
+   @param  void* Index of Worker (intptr_t).
+   @return void* Null Pointer.
+*/
+/*-----------------------------------------------------------------*/
+void* poolWorker(void*);
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Settle a Future Whose Batches Are All Finished (or Was
+           Cancelled): Reduce, Add Right Summation, Call Callback and
+           Wake Waiters. Called Without The Pool Mutex.
+   @param  BBPFuture* Future With finishing Set.
+*/
+/*-----------------------------------------------------------------*/
+void settleFuture(BBPFuture*);
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Choose The Job Whose Batch Runs Next. Jobs Without Batches
+           Left (Cancelled or Empty) Come First, so They Settle
+           Promptly. Static Jobs Are Skipped by Workers Whose Own
+           Batches Are All Taken.
+           Called With The Pool Mutex.
+   @param  double     Current Time.
+   @param  int        Index of Worker.
+   @return BBPFuture* Most Urgent Job (NULL = None For Worker).
+*/
+/*-----------------------------------------------------------------*/
+BBPFuture* pickJob(double, int);
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Take The Next Batches of a Job For a Worker, by The
+           Scheduler of The Job: One Batch (Equal), Several on Faster
+           Workers (Weighted), or Worker i Takes Batches i, i + n...
+           (Static). Called With The Pool Mutex.
+   @param  BBPFuture* Job With Batches Left For The Worker.
+   @param  int        Index of Worker.
+   @param  uint64_t*  First k of Batches.
+   @param  uint64_t*  Stride Between Batches.
+   @return uint64_t   Number of Batches.
+*/
+/*-----------------------------------------------------------------*/
+uint64_t takeBatches(BBPFuture*, int, uint64_t*, uint64_t*);
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Remove a Job From The Queue. Called With The Pool Mutex.
+   @param  BBPFuture* Queued Job.
+*/
+/*-----------------------------------------------------------------*/
+void unqueueJob(BBPFuture*);
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Current Time in Seconds (Monotonic).
+   @return double Seconds.
+*/
+/*-----------------------------------------------------------------*/
+static inline double now();
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Result of a Settled Future. Called With The Pool Mutex.
+   @param  BBPFuture*   Handle of Job.
+   @param  long double* Result, Set if Done (May be NULL).
+   @return FutureState  State of Future.
+*/
+/*-----------------------------------------------------------------*/
+static inline FutureState collect(BBPFuture*, long double*);
+
+
+/*-----------------------------------------------------------------
+                      Functions Implementation
+  -----------------------------------------------------------------*/
+static inline FutureState collect(BBPFuture* future, long double* result) {
+
+	if (!future -> settled)
+		return FUTURE_PENDING;
+
+	if (result && future -> state == FUTURE_DONE)
+		*result = future -> result;
+
+	return future -> state;
+}
+
+static inline double now() {
+
+	struct timespec time;
+
+	clock_gettime(CLOCK_MONOTONIC_RAW, &time);
+
+	return time.tv_sec + time.tv_nsec / 1e9;
+}
+
+void unqueueJob(BBPFuture* future) {
+
+	BBPFuture** link = &pool.head;
+
+	while (*link != future)
+		link = &(*link) -> next;
+
+	*link = future -> next;
+	future -> next = NULL;
+	future -> queued = false;
+}
+
+BBPFuture* pickJob(double time, int id) {
+
+	BBPFuture *best = NULL, *urgent = NULL;
+	double bestScore = INFINITY;
+
+	for (BBPFuture* future = pool.head; future; future = future -> next) {
+		const BBPJob* job = &future -> job;
+		uint64_t batchesLeft;
+		double score;
+
+		if (future -> cancelled || job -> count >= job -> upperBound)
+			return future;
+
+		if (job -> scheduler == SCHED_STATIC && future -> slots[id].next >= job -> upperBound)
+			continue;
+
+		batchesLeft = (job -> upperBound - job -> count + job -> batchSize - 1) /
+		              job -> batchSize;
+
+		// Deadline Would be Missed Without Priority, Earliest First
+		if (future -> deadline > 0.0 &&
+		    time + batchesLeft * pool.batchTime / pool.totalWorkers >= future -> deadline &&
+		    (!urgent || future -> deadline < urgent -> deadline))
+			urgent = future;
+
+		// Shortest Remaining Job First, Weighted by Priority and Age. In
+		// Log Space, as 2^age Would Overflow For Long Waits
+		score = log2((double) batchesLeft) - future -> priority -
+		        (time - future -> lastServed) / AGING_SECONDS;
+
+		if (score < bestScore) {
+			bestScore = score;
+			best = future;
+		}
+	}
+
+	return (urgent) ? urgent : best;
+}
+
+uint64_t takeBatches(BBPFuture* future, int id, uint64_t* s, uint64_t* stride) {
+
+	BBPJob* job = &future -> job;
+	WorkerSlot* slot = future -> slots + id;
+	uint64_t batches = 1;
+
+	if (job -> scheduler == SCHED_STATIC) {
+		*s = slot -> next;
+		*stride = pool.totalWorkers * job -> batchSize;
+		slot -> next += *stride;
+		job -> count += (job -> upperBound - *s < job -> batchSize) ?
+		                job -> upperBound - *s : job -> batchSize;
+		return 1;
+	}
+
+	if (job -> scheduler == SCHED_WEIGHTED && pool.totalWorkers > 1)
+		batches = batchesToTake(job, slot);
+
+	*s = job -> count;
+	*stride = job -> batchSize;
+	job -> count += batches * job -> batchSize;
+
+	return batches;
+}
+
+void settleFuture(BBPFuture* future) {
+
+	FutureState state = FUTURE_CANCELLED;
+	long double result = 0.0L;
+
+	if (!future -> cancelled) {
+		__uint128_t left = 0;
+
+		for (int i = 0; i < pool.totalWorkers; i++)
+			left += future -> slots[i].sum;
+
+		result = finishJob(&future -> job, left);
+		state = FUTURE_DONE;
+	}
+
+	pthread_mutex_lock(&pool.mutex);
+	future -> state = state;
+	future -> result = result;
+	future -> settleTime = now();
+	pthread_mutex_unlock(&pool.mutex);
+
+	if (future -> callback)
+		future -> callback(future, future -> userData);
+
+	// Waiters Only Return After The Callback, so They Can Free it
+	pthread_mutex_lock(&pool.mutex);
+	future -> settled = true;
+	pthread_cond_broadcast(&future -> settledCond);
+	pthread_mutex_unlock(&pool.mutex);
+}
+
+void* poolWorker(void* arg) {
+
+	int id = (intptr_t) arg;
+
+	pthread_mutex_lock(&pool.mutex);
+
+	while (true) {
+		BBPFuture* future;
+		BBPJob* job;
+		WorkerSlot* slot;
+		double start, elapsed;
+		uint64_t s, stride, batches, ran = 0;
+		__uint128_t sum = 0;
+
+		// Queue is Drained Before Stopping
+		while (!(future = pickJob(start = now(), id)) && (pool.head || pool.running))
+			pthread_cond_wait(&pool.work, &pool.mutex);
+
+		if (!future)
+			break;
+
+		job = &future -> job;
+		slot = future -> slots + id;
+
+		// No Batches Left, Settle When The Last in Flight Ends
+		if (future -> cancelled || job -> count >= job -> upperBound) {
+			unqueueJob(future);
+
+			if (!future -> inFlight && !future -> finishing) {
+				future -> finishing = true;
+				pthread_mutex_unlock(&pool.mutex);
+				settleFuture(future);
+				pthread_mutex_lock(&pool.mutex);
+			}
+
+			continue;
+		}
+
+		if (future -> startTime == 0.0)
+			future -> startTime = start;
+
+		batches = takeBatches(future, id, &s, &stride);
+		future -> inFlight++;
+		future -> lastServed = start;
+
+		if (job -> count >= job -> upperBound)
+			unqueueJob(future);
+
+		pthread_mutex_unlock(&pool.mutex);
+
+		// Batches Keep Their Boundaries, so Results Don't Depend on Who
+		// Took Them. A Cancelled Job Leaves The Rest Unrun
+		for (; ran < batches && s < job -> upperBound && !job -> stop; ran++, s += stride)
+			sum += runBatch(job, s);
+
+		slot -> sum += sum;
+		pthread_mutex_lock(&pool.mutex);
+
+		future -> inFlight--;
+		future -> leftEnd = now();
+		elapsed = (future -> leftEnd - start) / ((ran) ? ran : 1);
+		pool.batchTime = (pool.batchTime > 0.0) ?
+		                 pool.batchTime + BATCH_EWMA * (elapsed - pool.batchTime) : elapsed;
+		slot -> batchTime = (slot -> batchTime > 0.0) ?
+		                    slot -> batchTime + BATCH_EWMA * (elapsed - slot -> batchTime) : elapsed;
+
+		// Job Left The Queue While This Batch Ran
+		if (!future -> inFlight && !future -> finishing && !future -> queued) {
+			future -> finishing = true;
+			pthread_mutex_unlock(&pool.mutex);
+			settleFuture(future);
+			pthread_mutex_lock(&pool.mutex);
+		}
+	}
+
+	pthread_mutex_unlock(&pool.mutex);
+
+	return NULL;
+}
+
+int initAsync(uint16_t totalWorkers, PinPolicy pinning) {
+
+	pthread_mutex_lock(&pool.mutex);
+
+	if (pool.running || !totalWorkers) {
+		pthread_mutex_unlock(&pool.mutex);
+		return 1;
+	}
+
+	pool.places = (WorkerSlot*) aligned_alloc(ACC_ALIGN, totalWorkers * sizeof(WorkerSlot));
+	checkNullPointer((void*) pool.places);
+
+	for (int i = 0; i < totalWorkers; i++)
+		pool.places[i] = (WorkerSlot) {.sum = 0, .job = NULL, .cpu = -1, .weight = 1};
+
+	totalWorkers = placeWorkers(pool.places, totalWorkers, pinning);
+
+	pool.workers = (pthread_t*) malloc(totalWorkers * sizeof(pthread_t));
+	checkNullPointer((void*) pool.workers);
+
+	pool.totalWorkers = totalWorkers;
+	pool.running = true;
+	pool.head = NULL;
+	pool.batchTime = 0.0;
+
+	for (intptr_t i = 0; i < totalWorkers; i++) {
+		pthread_attr_t attr;
+
+		pthread_attr_init(&attr);
+
+		if (pool.places[i].cpu >= 0)
+			pinAttribute(&attr, pool.places[i].cpu);
+
+		if (pthread_create(pool.workers + i, &attr, &poolWorker, (void*) i) != 0) {
+			unexpectedError("Error Creating Threads!");
+		}
+
+		pthread_attr_destroy(&attr);
+	}
+
+	pthread_mutex_unlock(&pool.mutex);
+
+	return 0;
+}
+
+void freeAsync() {
+
+	pthread_mutex_lock(&pool.mutex);
+
+	if (!pool.running) {
+		pthread_mutex_unlock(&pool.mutex);
+		return;
+	}
+
+	pool.running = false;
+
+	for (BBPFuture* future = pool.head; future; future = future -> next) {
+		future -> cancelled = true;
+		future -> job.stop = true;
+	}
+
+	pthread_cond_broadcast(&pool.work);
+	pthread_mutex_unlock(&pool.mutex);
+
+	for (int i = 0; i < pool.totalWorkers; i++) {
+		if (pthread_join(pool.workers[i], NULL) != 0) {
+			unexpectedError("Error Joining Threads!");
+		}
+	}
+
+	free(pool.workers);
+	free(pool.places);
+	pool.workers = NULL;
+	pool.places = NULL;
+}
+
+uint16_t workersAsync() {
+
+	uint16_t totalWorkers;
+
+	pthread_mutex_lock(&pool.mutex);
+	totalWorkers = (pool.running) ? pool.totalWorkers : 0;
+	pthread_mutex_unlock(&pool.mutex);
+
+	return totalWorkers;
+}
+
+BBPFuture* submitBBP(const Config* configs, const JobOptions* options,
+                     BBPCallback callback, void* userData) {
+
+	BBPFuture* future;
+	pthread_condattr_t attr;
+	Config jobConfigs = *configs;
+
+	future = (BBPFuture*) calloc(1, sizeof(BBPFuture));
+	checkNullPointer((void*) future);
+
+	if (initJob(&future -> job, &jobConfigs)) {
+		free(future);
+		return NULL;
+	}
+
+	pthread_mutex_lock(&pool.mutex);
+
+	if (!pool.running) {
+		pthread_mutex_unlock(&pool.mutex);
+		free(future);
+		return NULL;
+	}
+
+	future -> slots = (WorkerSlot*) aligned_alloc(ACC_ALIGN,
+	                                              pool.totalWorkers * sizeof(WorkerSlot));
+	checkNullPointer((void*) future -> slots);
+
+	// Static Worker i Starts at Batch i, Weighted Ones From The Capacity
+	// of Their CPU, as in a Pinned Synchronous Job
+	for (int i = 0; i < pool.totalWorkers; i++) {
+		future -> slots[i] = pool.places[i];
+		future -> slots[i].job = &future -> job;
+		future -> slots[i].next = i * future -> job.batchSize;
+	}
+
+	future -> job.slots = future -> slots;
+	future -> job.activeThreads = pool.totalWorkers;
+
+	future -> callback = callback;
+	future -> userData = userData;
+	future -> state = FUTURE_PENDING;
+	future -> submitTime = future -> lastServed = now();
+
+	if (options) {
+		future -> priority = options -> priority;
+
+		if (options -> deadline > 0.0)
+			future -> deadline = future -> submitTime + options -> deadline;
+	}
+
+	// Timed Waits Use The Monotonic Clock
+	pthread_condattr_init(&attr);
+	pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+	pthread_cond_init(&future -> settledCond, &attr);
+	pthread_condattr_destroy(&attr);
+
+	future -> queued = true;
+	future -> next = pool.head;
+	pool.head = future;
+
+	pthread_cond_broadcast(&pool.work);
+	pthread_mutex_unlock(&pool.mutex);
+
+	return future;
+}
+
+FutureState statsBBP(BBPFuture* future, BBPStats* stats) {
+
+	const BBPJob* job = &future -> job;
+	double start;
+
+	pthread_mutex_lock(&pool.mutex);
+
+	if (!future -> settled) {
+		pthread_mutex_unlock(&pool.mutex);
+		return FUTURE_PENDING;
+	}
+
+	// Cancelled Before Any Batch Waited Until it Settled
+	start = (future -> startTime > 0.0) ? future -> startTime : future -> settleTime;
+
+	stats -> batchSize = job -> batchSize;
+	stats -> terms = 0;
+
+	for (int i = 0; i < job -> formula -> totalTerms; i++)
+		stats -> terms += job -> termBounds[i];
+
+	stats -> queueTime = start - future -> submitTime;
+	stats -> leftTime = (future -> leftEnd > start) ? future -> leftEnd - start : 0.0;
+	stats -> totalTime = future -> settleTime - future -> submitTime;
+	stats -> rightTime = stats -> totalTime - stats -> queueTime - stats -> leftTime;
+	stats -> errorBound = errorBound(job);
+	stats -> guaranteedDigits = (future -> state == FUTURE_DONE) ?
+	                            guaranteedDigits(future -> result, stats -> errorBound,
+	                                             2 * FRACTION_BYTES) : 0;
+	pthread_mutex_unlock(&pool.mutex);
+
+	return future -> state;
+}
+
+FutureState waitBBP(BBPFuture* future, long double* result) {
+
+	FutureState state;
+
+	pthread_mutex_lock(&pool.mutex);
+
+	while (!future -> settled)
+		pthread_cond_wait(&future -> settledCond, &pool.mutex);
+
+	state = collect(future, result);
+	pthread_mutex_unlock(&pool.mutex);
+
+	return state;
+}
+
+FutureState timedWaitBBP(BBPFuture* future, double seconds, long double* result) {
+
+	FutureState state;
+	struct timespec deadline;
+
+	clock_gettime(CLOCK_MONOTONIC, &deadline);
+	deadline.tv_sec += (time_t) seconds;
+	deadline.tv_nsec += (long) ((seconds - (time_t) seconds) * 1e9);
+
+	if (deadline.tv_nsec >= 1000000000L) {
+		deadline.tv_sec++;
+		deadline.tv_nsec -= 1000000000L;
+	}
+
+	pthread_mutex_lock(&pool.mutex);
+
+	while (!future -> settled)
+		if (pthread_cond_timedwait(&future -> settledCond, &pool.mutex, &deadline))
+			break;
+
+	state = collect(future, result);
+	pthread_mutex_unlock(&pool.mutex);
+
+	return state;
+}
+
+FutureState tryGetBBP(BBPFuture* future, long double* result) {
+
+	FutureState state;
+
+	pthread_mutex_lock(&pool.mutex);
+	state = collect(future, result);
+	pthread_mutex_unlock(&pool.mutex);
+
+	return state;
+}
+
+FutureState progressBBP(BBPFuture* future, BBPProgress* progress) {
+
+	const BBPJob* job = &future -> job;
+	uint64_t terms = 0, taken, running;
+	FutureState state;
+
+	for (int i = 0; i < job -> formula -> totalTerms; i++)
+		terms += job -> termBounds[i];
+
+	pthread_mutex_lock(&pool.mutex);
+
+	taken = (job -> count < job -> upperBound) ? job -> count : job -> upperBound;
+	running = future -> inFlight * job -> batchSize;
+
+	progress -> fraction = (job -> upperBound) ?
+	                       (double) ((taken > running) ? taken - running : 0) / job -> upperBound : 1.0;
+	progress -> elapsed = (future -> startTime > 0.0) ?
+	                      ((future -> settled) ? future -> settleTime : now()) - future -> startTime : 0.0;
+	progress -> termsPerSec = (progress -> elapsed > 0.0) ?
+	                          terms * progress -> fraction / progress -> elapsed : 0.0;
+	state = collect(future, NULL);
+
+	pthread_mutex_unlock(&pool.mutex);
+
+	return state;
+}
+
+void cancelBBP(BBPFuture* future) {
+
+	pthread_mutex_lock(&pool.mutex);
+
+	// Workers See The Flag When The Job Reaches The Queue Head
+	if (!future -> finishing) {
+		future -> cancelled = true;
+		future -> job.stop = true;
+	}
+
+	pthread_cond_broadcast(&pool.work);
+	pthread_mutex_unlock(&pool.mutex);
+}
+
+void freeFuture(BBPFuture* future) {
+
+	if (!future)
+		return;
+
+	cancelBBP(future);
+	waitBBP(future, NULL);
+
+	pthread_cond_destroy(&future -> settledCond);
+	free(future -> slots);
+	free(future);
+}
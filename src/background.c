@@ -0,0 +1,432 @@
+/*-----------------------------------------------------------------*/
+/**
+  @file   background.c
+  @author Flávio M.
+  @brief  Computations of The Menu, Run in Background on The Pool.
+ */
+/*-----------------------------------------------------------------*/
+
+/*-----------------------------------------------------------------
+                              Includes
+  -----------------------------------------------------------------*/
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/select.h>
+#include <unistd.h>
+#include "../include/async.h"
+#include "../include/background.h"
+#include "../include/bbp.h"
+#include "../include/formula.h"
+#include "../include/output.h"
+
+
+/*-----------------------------------------------------------------
+                            Definitions
+-----------------------------------------------------------------*/
+#define REFRESH_SECONDS 0.25   // Period of Progress Lines While Watching
+#define LIST_ROWS 10           // Running Jobs Shown in Menu Pages
+#define STATUS_WIDTH 78        // Columns of The Progress Line
+
+
+/*-----------------------------------------------------------------
+                          Structs and Enums
+-----------------------------------------------------------------*/
+
+// Computation Started From The Menu
+typedef struct {
+	int id;
+	Config configs;
+	BBPFuture* future;     // NULL Once Settled and Collected
+	FutureState state;
+	long double result;
+	BBPStats stats;
+	bool shown;            // Result Already Printed
+} BackgroundJob;
+
+
+/*-----------------------------------------------------------------
+                          Global Variables
+-----------------------------------------------------------------*/
+static BackgroundJob jobs[MAX_BACKGROUND_JOBS];
+static int totalJobs = 0;
+static int nextId = 1;
+static uint16_t poolWorkers = 0;
+static PinPolicy poolPinning = PIN_NONE;
+
+
+/*-----------------------------------------------------------------
+                   Internal Functions Signatures
+  -----------------------------------------------------------------*/
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Collect Jobs That Settled, Freeing Their Futures.
+   @return int Number of Jobs Still Running or Queued.
+*/
+/*-----------------------------------------------------------------*/
+int refreshJobs();
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Make Room For a Job, Dropping The Oldest Finished One.
+   @return int Error(1) /Success(0) Code in Operation.
+*/
+/*-----------------------------------------------------------------*/
+int makeRoom();
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Start or Resize The Pool. Resized (or Pinned Again) Only
+           When Idle.
+   @param  uint16_t  Wanted Workers.
+   @param  PinPolicy Placement of Workers.
+   @return int       Error(1) /Success(0) Code in Operation.
+*/
+/*-----------------------------------------------------------------*/
+int preparePool(uint16_t, PinPolicy);
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Format The Digits of a Finished Job, Digits Past The
+           Error Bound in Brackets.
+   @param  const BackgroundJob* Finished Job.
+   @param  char*                Buffer (At Least MAX_DIGITS + 3).
+*/
+/*-----------------------------------------------------------------*/
+void jobDigits(const BackgroundJob*, char*);
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief Print The Result Line of a Settled Job.
+   @param BackgroundJob* Settled Job (Marked as Shown).
+*/
+/*-----------------------------------------------------------------*/
+void showResult(BackgroundJob*);
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Wait For Standard Input to Have a Line.
+   @param  double Timeout in Seconds.
+   @return bool   A Line Was Read.
+*/
+/*-----------------------------------------------------------------*/
+bool lineWithin(double);
+
+
+/*-----------------------------------------------------------------
+                      Functions Implementation
+  -----------------------------------------------------------------*/
+int refreshJobs() {
+
+	int running = 0;
+
+	for (int i = 0; i < totalJobs; i++) {
+		BackgroundJob* job = jobs + i;
+
+		if (!job -> future)
+			continue;
+
+		job -> state = statsBBP(job -> future, &job -> stats);
+
+		if (job -> state == FUTURE_PENDING) {
+			running++;
+			continue;
+		}
+
+		tryGetBBP(job -> future, &job -> result);
+		freeFuture(job -> future);
+		job -> future = NULL;
+	}
+
+	return running;
+}
+
+int makeRoom() {
+
+	if (totalJobs < MAX_BACKGROUND_JOBS)
+		return 0;
+
+	for (int i = 0; i < totalJobs; i++) {
+		if (jobs[i].future)
+			continue;
+
+		memmove(jobs + i, jobs + i + 1, (totalJobs - i - 1) * sizeof(BackgroundJob));
+		totalJobs--;
+
+		return 0;
+	}
+
+	return 1;
+}
+
+int preparePool(uint16_t workers, PinPolicy pinning) {
+
+	if (!workers)
+		workers = 1;
+
+	if (poolWorkers == workers && poolPinning == pinning)
+		return 0;
+
+	// Running Jobs Keep The Pool They Were Given
+	if (poolWorkers && refreshJobs())
+		return 0;
+
+	if (poolWorkers)
+		freeAsync();
+
+	poolWorkers = 0;
+
+	if (initAsync(workers, pinning))
+		return 1;
+
+	poolWorkers = workers;
+	poolPinning = pinning;
+
+	return 0;
+}
+
+int queueComputation(const Config* configs) {
+
+	BackgroundJob* job;
+
+	refreshJobs();
+
+	if (makeRoom()) {
+		fprintf(stderr, "\nToo Many Jobs Running! Cancel or Wait For One.\n");
+		return -1;
+	}
+
+	if (preparePool(configs -> nthreads, configs -> pinning)) {
+		fprintf(stderr, "\nWorker Pool Couldn't be Started!\n");
+		return -1;
+	}
+
+	job = jobs + totalJobs;
+	memset(job, 0, sizeof(BackgroundJob));
+	job -> configs = *configs;
+	job -> configs.nthreads = workersAsync();
+	job -> configs.pinning = poolPinning;
+	job -> state = FUTURE_PENDING;
+	job -> future = submitBBP(configs, NULL, NULL, NULL);
+
+	if (!job -> future) {
+		fprintf(stderr, "\nAlgorithm Not Found or Offset Too Large For Formula!\n");
+		return -1;
+	}
+
+	job -> id = nextId++;
+	totalJobs++;
+
+	return job -> id;
+}
+
+int cancelComputation(int id) {
+
+	for (int i = 0; i < totalJobs; i++) {
+		if (jobs[i].id != id)
+			continue;
+
+		if (!jobs[i].future)
+			return 1;
+
+		cancelBBP(jobs[i].future);
+		refreshJobs();
+
+		return 0;
+	}
+
+	return 1;
+}
+
+void jobDigits(const BackgroundJob* job, char* out) {
+
+	uint8_t bytes[FRACTION_BYTES];
+	char digits[MAX_DIGITS + 1];
+	int precision = (job -> configs.digits) ? job -> configs.digits : PRECISION;
+	int sure = job -> stats.guaranteedDigits;
+
+	if (precision > MAX_DIGITS)
+		precision = MAX_DIGITS;
+
+	packFraction(job -> result, bytes, (precision + 1) / 2);
+	formatDigits(bytes, precision * 4, DIGITS_HEX, digits, sizeof(digits));
+
+	if (sure < precision)
+		sprintf(out, "%.*s[%s]", sure, digits, digits + sure);
+	else
+		strcpy(out, digits);
+}
+
+void showResult(BackgroundJob* job) {
+
+	char digits[MAX_DIGITS + 3];
+	const char* key = getFormula(job -> configs.algo) -> key;
+
+	job -> shown = true;
+
+	if (job -> state == FUTURE_CANCELLED) {
+		printf("#%-3d %-9s @ %-14lu Cancelled\n", job -> id, key, job -> configs.startPos);
+		return;
+	}
+
+	jobDigits(job, digits);
+	printf("#%-3d %-9s @ %-14lu = %s (%.5fs, %.1f M Terms/s)\n", job -> id, key,
+	       job -> configs.startPos, digits, job -> stats.totalTime,
+	       (job -> stats.leftTime > 0.0) ?
+	       job -> stats.terms / job -> stats.leftTime / 1e6 : 0.0);
+}
+
+bool lineWithin(double seconds) {
+
+	struct timeval timeout = {(time_t) seconds, (suseconds_t) ((seconds - (time_t) seconds) * 1e6)};
+	char line[64];
+	fd_set input;
+
+	FD_ZERO(&input);
+	FD_SET(STDIN_FILENO, &input);
+
+	if (select(STDIN_FILENO + 1, &input, NULL, NULL, &timeout) <= 0)
+		return false;
+
+	// Rest of a Long Line is Dropped Too
+	while (fgets(line, sizeof(line), stdin) && !strchr(line, '\n'));
+
+	return true;
+}
+
+int watchComputations() {
+
+	int running = refreshJobs();
+
+	printf("\nWatching Jobs, Press Enter to Return (Jobs Keep Running)\n\n");
+
+	while (true) {
+		char status[STATUS_WIDTH + 1] = "";
+		size_t used = 0;
+
+		for (int i = 0; i < totalJobs; i++)
+			if (!jobs[i].future && !jobs[i].shown)
+				showResult(jobs + i);
+
+		if (!running)
+			break;
+
+		// Progress of Every Running Job on a Single Line, Redrawn
+		for (int i = 0; i < totalJobs && used + 24 < sizeof(status); i++) {
+			BBPProgress progress;
+
+			if (!jobs[i].future)
+				continue;
+
+			progressBBP(jobs[i].future, &progress);
+
+			if (progress.elapsed == 0.0)
+				used += snprintf(status + used, sizeof(status) - used, "[#%d Queued] ", jobs[i].id);
+			else
+				used += snprintf(status + used, sizeof(status) - used, "[#%d %5.1f%% %.1f M/s] ",
+				                 jobs[i].id, 100.0 * progress.fraction, progress.termsPerSec / 1e6);
+		}
+
+		printf("\r%-*s\r", STATUS_WIDTH, status);
+		fflush(stdout);
+
+		if (lineWithin(REFRESH_SECONDS))
+			break;
+
+		printf("\r%*s\r", STATUS_WIDTH, "");
+		running = refreshJobs();
+	}
+
+	printf("\r%*s\r", STATUS_WIDTH, "");
+	fflush(stdout);
+
+	return running;
+}
+
+int runningComputations() {
+	return refreshJobs();
+}
+
+int listComputations(char* buffer, size_t size) {
+
+	size_t used = 0;
+	int listed = 0;
+
+	refreshJobs();
+	buffer[0] = '\0';
+
+	for (int i = 0; i < totalJobs && listed < LIST_ROWS; i++) {
+		BBPProgress progress;
+
+		if (!jobs[i].future)
+			continue;
+
+		progressBBP(jobs[i].future, &progress);
+
+		if (used < size)
+			used += snprintf(buffer + used, size - used, "#%-3d %-9s @ %-14lu %s%5.1f%%\n",
+			                 jobs[i].id, getFormula(jobs[i].configs.algo) -> key,
+			                 jobs[i].configs.startPos,
+			                 (progress.elapsed == 0.0) ? "Queued " : "Running", 100.0 * progress.fraction);
+		listed++;
+	}
+
+	return listed;
+}
+
+void printHistory() {
+
+	refreshJobs();
+
+	if (!totalJobs) {
+		printf("\nNo Jobs Yet.\n");
+		return;
+	}
+
+	printf("\n%-4s %-9s %-14s %-7s %-19s %-10s %-10s %-10s %s\n", "Id", "Formula",
+	       "Offset", "Threads", "Digits", "Queue (s)", "Left (s)", "Total (s)", "M Terms/s");
+
+	for (int i = 0; i < totalJobs; i++) {
+		const BackgroundJob* job = jobs + i;
+		char digits[MAX_DIGITS + 3] = "";
+
+		if (job -> future) {
+			printf("%-4d %-9s %-14lu %-7d %s\n", job -> id, getFormula(job -> configs.algo) -> key,
+			       job -> configs.startPos, job -> configs.nthreads, "Running");
+			continue;
+		}
+
+		if (job -> state == FUTURE_DONE)
+			jobDigits(job, digits);
+		else
+			strcpy(digits, "Cancelled");
+
+		printf("%-4d %-9s %-14lu %-7d %-19s %-10.5f %-10.5f %-10.5f %.1f\n", job -> id,
+		       getFormula(job -> configs.algo) -> key, job -> configs.startPos,
+		       job -> configs.nthreads, digits, job -> stats.queueTime, job -> stats.leftTime,
+		       job -> stats.totalTime, (job -> stats.leftTime > 0.0) ?
+		       job -> stats.terms / job -> stats.leftTime / 1e6 : 0.0);
+	}
+}
+
+void freeComputations() {
+
+	for (int i = 0; i < totalJobs; i++)
+		if (jobs[i].future)
+			freeFuture(jobs[i].future);
+
+	totalJobs = 0;
+
+	if (poolWorkers)
+		freeAsync();
+
+	poolWorkers = 0;
+}
@@ -17,47 +17,103 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdbool.h>
+#include <string.h>
 #include <time.h>
 #include <unistd.h>
 #include "../include/bbp.h"
+#include "../include/job.h"
+#include "../include/modular.h"
+#include "../include/output.h"
+#include "../include/report.h"
 #include "../include/timer.h"
+#include "../include/topology.h"
 
 
 /*-----------------------------------------------------------------
                             Definitions
 -----------------------------------------------------------------*/
-#define PRECISION 10     // Number of Digits after Starting Position
-#define EPSILON 1e-17    // Epsilon For Floating Point Precision
-#define TOTAL_ACC 15     // Total Accumulators
+#define TAIL_GUARD 8     // Bits Kept Past The Digits Wanted by Right Summations
+#define CHUNK 8          // k Sharing One Divide in The Left Summation
+#define TERM_ULPS (2 * CHUNK + 9) // Relative Error of a Left Term, in Units of 2^-64
+#define TAIL_ULPS 8      // Relative Error of a Right Term, in Units of 2^-64
 //#define DEBUG            // If Code is In Debug Mode
+//#define FORCE_WIDE       // Use 128-Bit Arithmetic at Every Offset
 
 
 /*-----------------------------------------------------------------
-                          Global Variables
+                         Kernels Generation
 -----------------------------------------------------------------*/
-Algorithm algoInUse;
-uint64_t upperBound;
-long double (*leftSum) (uint64_t);     // Wrapper For Left Summation Function
-long double (*rightSum)();             // Wrapper For Right Summation Function
-
-// Upperbounds For Bellard Formula Terms
-int64_t upperBoundNeg1, upperBoundNeg6, upperBoundNeg4, upperBound0, upperBound2;
 
+/*-----------------------------------------------------------------*/
+/**
+   @brief Generate Left Summation, Right Summation and Upper Bound
+          Functions For a Built-in Formula (See formula.h), With
+          Every Constant Known at Compile Time. The Left Summation
+          Iterates Over k Once, With Every Term Unrolled Inside.
+*/
+/*-----------------------------------------------------------------*/
+#define DEFINE_FORMULA(ID, NAME, KEY, DESC, SHIFT, POW_BITS, SIGNS, POWER, TERMS) \
+	uint64_t NAME##Bound(const BBPJob* job) {                         \
+		const uint64_t d = job -> d;                                  \
+		const int shift = SHIFT;                                      \
+		uint64_t bound = 0;                                           \
+		TERMS(BOUND_TERM)                                             \
+		return bound;                                                 \
+	}                                                                 \
+                                                                      \
+	long double NAME##LfS(const BBPJob* job, uint64_t s) {            \
+		const uint64_t d = job -> d;                                  \
+		const int shift = SHIFT, powBits = POW_BITS, power = POWER;   \
+		long double sum = 0.0L, terms[CHUNK];                         \
+		uint64_t loopLimit = s + job -> batchSize;                    \
+                                                                      \
+		if (loopLimit > job -> upperBound)                            \
+			loopLimit = job -> upperBound;                            \
+                                                                      \
+		for (uint64_t k0 = s; k0 < loopLimit; k0 += CHUNK) {          \
+			const int size = (loopLimit - k0 < CHUNK) ?               \
+			                 loopLimit - k0 : CHUNK;                  \
+                                                                      \
+			for (int c = 0; c < size; c++)                            \
+				terms[c] = 0.0L;                                      \
+                                                                      \
+			TERMS(LEFT_TERM)                                          \
+                                                                      \
+			for (int c = 0; c < size; c++) {                          \
+				sum += negativeAt(SIGNS, sizeof(SIGNS) - 1, k0 + c) ? \
+				       -terms[c] : terms[c];                          \
+				sum = fmodl(sum, 1.0L);                               \
+			}                                                         \
+		}                                                             \
+                                                                      \
+		return sum;                                                   \
+	}                                                                 \
+                                                                      \
+	long double NAME##RfS(const BBPJob* job) {                        \
+		const uint64_t d = job -> d;                                  \
+		const int shift = SHIFT, power = POWER;                       \
+		const char* signs = SIGNS;                                    \
+		const int period = sizeof(SIGNS) - 1;                         \
+		long double result = 0.0L;                                    \
+		TERMS(RIGHT_TERM)                                             \
+		return fmodl(result, 1.0L);                                   \
+	}
 
-uint16_t activeThreads;                     // Threads Used
-uint64_t d;                                  // Starting Position
+#define BOUND_TERM(m, j, l, coef)                   \
+	if (termBound(d, l, shift) > bound)             \
+		bound = termBound(d, l, shift);
 
-// Number of Elements Each Thread Will Work Per Interation
-uint64_t batchSize = 100;
+#define LEFT_TERM(m, j, l, coef)                           \
+	chunkLeft(d, m, j, l, coef, shift, powBits, power, \
+	          termBound(d, l, shift), k0, size, terms);
 
+#define RIGHT_TERM(m, j, l, coef)                                \
+	result += termRightSum(d, m, j, l, coef, shift, power, signs, \
+	                       period, 4 * job -> digits + TAIL_GUARD);
 
-pthread_mutex_t counterMutex, accIndexMutex;
-uint64_t count = 0;
-long double acc[TOTAL_ACC] = {0};
-pthread_mutex_t accMutex[TOTAL_ACC];
-int accIndex = 0;
+#define KERNELS_ENTRY(ID, NAME, ...) \
+	[ID] = {NAME##LfS, NAME##RfS, NAME##Bound},
 
-MyTimer* total = NULL; 
 
 /*-----------------------------------------------------------------
                    Internal Functions Signatures
@@ -65,208 +121,243 @@ MyTimer* total = NULL;
 
 /*-----------------------------------------------------------------*/
 /**
-   @brief  Execute BBP Algo Starting at d up to n Digits.
-   @param  uint64_t   Starting Digit.
-   @return long double Fractional Part Containing The Result.
+   @brief  Fractional Part of a Number in 128-Bit Fixed Point. Every
+           Bit of The long double Mantissa is Kept, and Integer Sums
+           Don't Depend on Order, so Batch Results Add Up to The Same
+           Bits With Any Number of Threads.
+   @param  long double Number.
+   @return __uint128_t frac(x) * 2^128.
 */
 /*-----------------------------------------------------------------*/
-long double bbpAlgo();
+static inline __uint128_t toFixed(long double);
 
 
 /*-----------------------------------------------------------------*/
 /**
-   @brief  Modular Exponentiation Algorithm (b^x mod n).
-   @param  uint64_t Exponentiation base (b).
-   @param  uint64_t Exponent (x).
-   @param  uint64_t Modular Base (n).
-   @return uint64_t Result of modular exp.
+   @brief  Number From 128-Bit Fixed Point.
+   @param  __uint128_t frac * 2^128.
+   @return long double Fraction in [0, 1).
 */
 /*-----------------------------------------------------------------*/
-uint64_t modPow(uint64_t, uint64_t, uint64_t);
+static inline long double fromFixed(__uint128_t);
 
 
 /*-----------------------------------------------------------------*/
 /**
-   @brief Print Result of BBP Algo (Base 16).
-   @param long double Fraction Returned by bbpAlgo().
+   @brief  Current Time of a Monotonic Clock.
+   @return double Time in Seconds.
 */
 /*-----------------------------------------------------------------*/
-void ihex(long double);
+static inline double now();
 
 
 /*-----------------------------------------------------------------*/
 /**
-   @brief Init/Destroy All Threads and Mutexes.
+   @brief  CPU Time of The Calling Thread, Unaffected by Preemption.
+   @return double Seconds.
 */
 /*-----------------------------------------------------------------*/
-void initThreads();
+static inline double threadNow();
 
 
 /*-----------------------------------------------------------------*/
 /**
-   @brief  Thread Function That Calculate BBP Left Summation at
-           BatchSize Elements Per Iteration.
-   @param  void* Null Pointer.
-   @return void* Null Pointer.
+   @brief  Modular Exponentiation Algorithm (b^x mod n).
+   @param  uint64_t Exponentiation base (b).
+   @param  uint64_t Exponent (x).
+   @param  uint64_t Modular Base (n).
+   @return uint64_t Result of modular exp.
 */
 /*-----------------------------------------------------------------*/
-void* thPool(void*);
+uint64_t modPow(uint64_t, uint64_t, uint64_t);
 
 
 /*-----------------------------------------------------------------*/
 /**
-   @brief  Left Summation For Original Formula (4-Terms). Calculates
-           Sum from k to k + batchSize (or to d).
-   @param  int         j Value used in Summation, Different For
-                       Each Term.
-   @param  uint64_t    Current Starting Position (k).
-   @return long double Result of Summation.
+   @brief Init/Destroy All Threads and Mutexes. With a Single
+          Thread, The Work is Done in The Calling Thread.
+   @param BBPJob* Job Initialized by initJob.
 */
 /*-----------------------------------------------------------------*/
-long double lhs(int, uint64_t);
+void initThreads(BBPJob*);
 
 
 /*-----------------------------------------------------------------*/
 /**
-   @brief  Right Summation For Original Formula (4-Terms). Calculates
-           Sum from d until values are insignificant (< EPSILON).
-   @param  int         j Value used in Summation, Different For
-                       Each Term.
-   @return long double Result of Summation.
+   @brief  Thread Function That Calculate BBP Left Summation at
+           BatchSize Elements Per Iteration.
+   @param  void* Pointer to WorkerSlot of The Thread.
+   @return void* Null Pointer.
 */
 /*-----------------------------------------------------------------*/
-long double rhs(int);
+void* thPool(void*);
 
 
 /*-----------------------------------------------------------------*/
 /**
-   @brief  Calculate Left Summation from k to k + batchSize for Every
-           Term in the Original Formula (4-Term).
-   @param  uint64_t    Current Starting Position (k).
-   @return long double Result of Summation.
+   @brief  Thread Function of The Static Scheduler: Worker i Runs
+           Batches i, i + n, i + 2n... Without Taking The Counter
+           Lock, Adding What it Covered to The Count When Done.
+   @param  void* Pointer to WorkerSlot of The Thread.
+   @return void* Null Pointer.
 */
 /*-----------------------------------------------------------------*/
-long double bbpAlgoOriginalLfS(uint64_t);
+void* staticPool(void*);
 
 
 /*-----------------------------------------------------------------*/
 /**
-   @brief  Calculate Right Summation, for every Term in The Original
-           Formula (4-Terms) from d until value are
-		   insignificant (< EPSILON).
-   @return long double Result of Summation.
+   @brief  Upper Bound (First k Handled by The Right Summation) of
+           a Term, k < (4d + l) / shift.
+   @param  uint64_t Starting Position (d).
+   @param  int      l Value of The Term.
+   @param  int      Bits Shifted Per k.
+   @return uint64_t Upper Bound For The Term (0 if Negative).
 */
 /*-----------------------------------------------------------------*/
-long double bbpAlgoOriginalRfS();
+static inline uint64_t termBound(uint64_t, int, int);
 
 
 /*-----------------------------------------------------------------*/
 /**
-   @brief  Left Summation For Bellard Formula (7-Terms). Calculates
-           Sum from k to k + batchSize (or to upperBoundn). 
-		   Uses S(m, j, l) notation.
-   @param  int         m Value used in Summation.
-   @param  int         j Value used in Summation.
-   @param  int         l Value used in Summation.
-   @param  uint64_t    Current Starting Position (k).
-   @param  uint64_t    Upper Bound For Current Term.
-   @return long double Result of Summation.
+   @brief  If Sign of Term k is Negative in a Sign Pattern.
+   @param  const char* Sign Pattern ("+-" = (-1)^k).
+   @param  int         Period of Sign Pattern.
+   @param  uint64_t    Current Position (k).
+   @return bool        If Sign is Negative.
 */
 /*-----------------------------------------------------------------*/
-long double lhsBell(int, int, int, uint64_t, int64_t);
+static inline bool negativeAt(const char*, int, uint64_t);
 
 
 /*-----------------------------------------------------------------*/
 /**
-   @brief  Right Summation For Bellard Formula (7-Terms). Calculates
-           Sum from upperBoundn until value are
-		   insignificant (< EPSILON).
-		   Uses S(m, j, l) notation.
-   @param  int         m Value used in Summation.
-   @param  int         j Value used in Summation.
-   @param  int         l Value used in Summation.
-   @param  uint64_t    Upper Bound For Current Term.
-   @return long double Result of Summation.
+   @brief  Barrett Modular Exponentiation of a Whole Chunk, With The
+           CHUNK Chains Interleaved. Each Chain Alone is Bound by The
+           Latency of modMul, Interleaved They Keep The Multipliers
+           Busy. Lanes With Exponent 0 Result in 1.
+   @param  uint64_t        Number (n), Shared by All Lanes.
+   @param  const uint64_t* Exponents.
+   @param  const uint64_t* Bases (< 2^FAST_BITS).
+   @param  const uint64_t* Barrett Factors of The Bases.
+   @param  uint64_t*       n^exp mod base of Each Lane.
 */
 /*-----------------------------------------------------------------*/
-long double rhsBell(int, int, int, int64_t);
+static inline __attribute__((always_inline))
+void chunkPowBarret(uint64_t, const uint64_t*, const uint64_t*,
+                    const uint64_t*, uint64_t*);
 
 
 /*-----------------------------------------------------------------*/
 /**
-   @brief  Left Summation For Bellard Formula (7-Terms). Calculates
-           Sum from k to k + batchSize (or to upperBoundn) For Every 
-		   Term.
-   @param  uint64_t    Current Starting Position (k).
-   @return long double Result of Summation.
+   @brief  Add a Term to The Sums of a Chunk of k, Without The Sign
+           of k. The Reciprocals of The Chunk Moduli Come From a
+           Single Divide, and Also Give The Barrett Factors and
+           Montgomery Constants, so No Other Divide is Needed. The
+           Barrett Exponentiations of The Chunk Run Interleaved.
+           Always Inlined, So Each Call Site in The Generated
+           Kernels is Specialized With Its Own Constants.
+   @param  uint64_t     Starting Position (d).
+   @param  int          m Value of The Term.
+   @param  int          j Value of The Term.
+   @param  int          l Value of The Term.
+   @param  int          Coefficient of The Term.
+   @param  int          Bits Shifted Per k.
+   @param  int          Bits of Base Used in Modular Exp (1, 2 or 4).
+   @param  int          Power of Denominator.
+   @param  uint64_t     Upper Bound of The Term.
+   @param  uint64_t     First k of Chunk.
+   @param  int          Size of Chunk (<= CHUNK).
+   @param  long double* Sums of Chunk, Added coef * (2^(4d + l -
+                        shift*k) mod r) / r For Each k Below Bound.
 */
 /*-----------------------------------------------------------------*/
-long double bellardLfS(uint64_t);
+static inline __attribute__((always_inline))
+void chunkLeft(uint64_t, int, int, int, int, int, int, int,
+               uint64_t, uint64_t, int, long double*);
 
 
 /*-----------------------------------------------------------------*/
 /**
-   @brief  Right Summation For Bellard Formula (7-Terms). Calculates
-           Sum, for every term, from upperBoundn until value are
-		   insignificant (< EPSILON).
+   @brief  Right Summation of a Single Term. Calculates Sum from The
+           Term Upper Bound Over The Terms Given by tailLength.
+   @param  uint64_t    Starting Position (d).
+   @param  int         m Value of The Term.
+   @param  int         j Value of The Term.
+   @param  int         l Value of The Term.
+   @param  int         Coefficient of The Term.
+   @param  int         Bits Shifted Per k.
+   @param  int         Power of Denominator.
+   @param  const char* Sign Pattern.
+   @param  int         Period of Sign Pattern.
+   @param  int         Bits of Result Wanted.
    @return long double Result of Summation.
 */
 /*-----------------------------------------------------------------*/
-long double bellardRfs();
+static inline __attribute__((always_inline))
+long double termRightSum(uint64_t, int, int, int, int, int, int, const char*, int, int);
 
 
 /*-----------------------------------------------------------------*/
 /**
-   @brief  Implement Barret Reduction Algorithm.
-   @param  __uint128_t a*b Calculate in modMul Function.
-   @param  uint64_t    Base of Current Operation.
-   @param  uint64_t    Factor Used For Reduction.
-   @return uint64_t    n mod base.
+   @brief  Number of Right Summation Terms Needed For a Term, so The
+           Ones Left Out Add Below 2^-bits. Terms Start at Most at
+           coef * 2^e / r (e < shift) and Shrink by 2^shift Per k,
+           so The Rest After t of Them is Below 2 * coef * 2^(e -
+           shift * t) / r.
+   @param  uint64_t     Starting Position (d).
+   @param  int          m Value of The Term.
+   @param  int          j Value of The Term.
+   @param  int          l Value of The Term.
+   @param  int          Coefficient of The Term.
+   @param  int          Bits Shifted Per k.
+   @param  int          Power of Denominator.
+   @param  int          Bits of Result Wanted.
+   @param  long double* Bound on The Terms Left Out (May be NULL).
+   @return uint64_t     Number of Terms.
 */
 /*-----------------------------------------------------------------*/
-uint64_t barretReduction(__uint128_t, uint64_t, uint64_t);
+static inline uint64_t tailLength(uint64_t, int, int, int, int, int, int, int,
+                                  long double*);
 
 
 /*-----------------------------------------------------------------*/
 /**
-   @brief  Implements a Modular Multiplication.
-   @param  uint64_t Number to Be Multiplied (a).
-   @param  uint64_t Number to Be Multiplied (b).
-   @param  uint64_t    Base of Current Operation.
-   @param  uint64_t    Factor Used For Reduction.
-   @return uint64_t    a*b mod base.
+   @brief  Kernels For Formulas Added at Run Time, Reading The Terms
+           From The Job Formula.
+           genericLfS -> Left Summation from k to k + batchSize.
+           genericRfS -> Right Summation from Each Term Upper Bound.
+           genericBound -> Largest Upper Bound of The Terms.
 */
 /*-----------------------------------------------------------------*/
-uint64_t modMul(uint64_t, uint64_t, uint64_t, uint64_t);
+long double genericLfS(const BBPJob*, uint64_t);
+long double genericRfS(const BBPJob*);
+uint64_t genericBound(const BBPJob*);
 
 
 /*-----------------------------------------------------------------*/
 /**
-   @brief  Implements Barrett Modular Exponentiation Algorithm.
-   @param  uint64_t Number (n).
-   @param  uint64_t Exponent (exp).
-   @param  uint64_t Base of Current Operation.
-   @return uint64_t n^exp mod base.
+   @brief  Left Summation (k to k + batchSize) With 128-Bit Exponents
+           and Moduli, For Offsets Where 4d or (mk + j)^power Don't
+           Fit in 63 Bits. Reads The Terms From The Job Formula.
+   @param  const BBPJob* Job Initialized by initJob.
+   @param  uint64_t      First k of Batch.
+   @return long double   Result of Summation.
 */
 /*-----------------------------------------------------------------*/
-uint64_t modPowBarret(uint64_t, uint64_t, uint64_t);
+long double wideLfS(const BBPJob*, uint64_t);
 
 
 /*-----------------------------------------------------------------*/
 /**
-   @brief Config Variables and Function for Algorithm Selected.
-   @param Algoritghm Current Algorithm.
+   @brief  If a Job Needs The Wide Kernel, or Can't be Computed at
+           All (Bounds or Moduli Beyond 128-Bit Arithmetic).
+   @param  BBPJob* Job With Formula, d and Term Bounds Set.
+   @return int     Fits 64 Bits(0) /Needs 128 Bits(1) /Too Large(-1).
 */
 /*-----------------------------------------------------------------*/
-void configAlgorithm();
-
+int wideNeeded(const BBPJob*);
 
-/*-----------------------------------------------------------------*/
-/**
-   @brief Reset Global Variables.
-*/
-/*-----------------------------------------------------------------*/
-void resetVariables();
 
 /*-----------------------------------------------------------------
                       Functions Implementation
@@ -276,8 +367,9 @@ uint64_t barretReduction(__uint128_t n,
                          uint64_t base,
                          uint64_t factor) {
 
-	uint64_t q = ((__uint128_t)n * factor) >> 64;
-	q = n - ((__uint128_t)q * base);
+	uint64_t hi = n >> 64, lo = n;
+	uint64_t q = hi * factor + (((__uint128_t) lo * factor) >> 64);
+	q = lo - q * base;
         
 	while (q >= base)
 		q -= base;
@@ -315,325 +407,805 @@ uint64_t modPowBarret(uint64_t n,
 }        
 
 
-long double lhs(int j, uint64_t s) {
+static inline __uint128_t toFixed(long double x) {
 
-	long double r, sum = 0.0L, mult = -1, temp;
-	uint64_t loopLimit = s + batchSize;
+	long double high = ldexpl(x - floorl(x), 64);
+	uint64_t hi, lo;
 
-	if (j == 1)
-		mult = 4;
-	else if (j == 4)
-		mult = -2;
+	// Values Like -1e-30 Round Up to 1.0
+	if (high >= 0x1p64L)
+		return 0;
 
-	if (loopLimit > upperBound)
-		loopLimit = upperBound;
+	hi = high;
+	lo = ldexpl(high - hi, 64);
 
-	for (uint64_t k = s; k < loopLimit; k++) {
-		r = 8.0L * k + j;
-		temp = modPowBarret(16, upperBound - k, r);
-		sum += (mult * temp) / r;
-	    sum = fmodl(sum, 1.0L);
+	return ((__uint128_t) hi << 64) | lo;
+}
+
+static inline long double fromFixed(__uint128_t x) {
+	return ldexpl((uint64_t) (x >> 64), -64) + ldexpl((uint64_t) x, -128);
+}
+
+static inline double now() {
+
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC_RAW, &ts);
+
+	return ts.tv_sec + ts.tv_nsec / 1000000000.0;
+}
+
+static inline double threadNow() {
+
+	struct timespec ts;
+
+	clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+
+	return ts.tv_sec + ts.tv_nsec / 1000000000.0;
+}
+
+static inline uint64_t termBound(uint64_t d, int l, int shift) {
+
+	__int128_t bound = ((__int128_t) 4 * d + l) / shift;
+
+	if (bound > (__int128_t) UINT64_MAX)
+		return UINT64_MAX;
+
+	return (bound < 0) ? 0 : bound;
+}
+
+static inline uint64_t tailLength(uint64_t d, int m, int j, int l, int coef,
+                                  int shift, int power, int bits,
+                                  long double* cutOff) {
+
+	uint64_t bound = termBound(d, l, shift), length = 0;
+	int e = (__int128_t) 4 * d + l - (__int128_t) shift * bound;
+	long double r = (long double) m * bound + j;
+	long double first, needed;
+
+	if (power > 1)
+		r *= r;
+
+	// Smallest t With 2 * coef * 2^(e - shift * t) / r <= 2^-bits
+	first = 2 * abs(coef) / r;
+	needed = bits + e + log2l(first);
+
+	if (needed > 0)
+		length = ceill(needed / shift);
+
+	if (cutOff)
+		*cutOff = ldexpl(first, e - shift * (int64_t) length);
+
+	return length;
+}
+
+static inline bool negativeAt(const char* signs, int period, uint64_t k) {
+	return signs[k % period] == '-';
+}
+
+static inline __attribute__((always_inline))
+void chunkPowBarret(uint64_t n, const uint64_t* exp, const uint64_t* base,
+                    const uint64_t* factor, uint64_t* result) {
+
+	uint64_t e[CHUNK], x[CHUNK], pending = 0;
+
+	for (int c = 0; c < CHUNK; c++) {
+		e[c] = exp[c];
+		x[c] = n;
+		result[c] = 1;
+		pending |= e[c];
 	}
 
-	return sum;
+	while (pending) {
+		pending = 0;
+
+		for (int c = 0; c < CHUNK; c++) {
+			if (e[c] & 1)
+				result[c] = modMul(result[c], x[c], base[c], factor[c]);
+
+			x[c] = modMul(x[c], x[c], base[c], factor[c]);
+			e[c] >>= 1;
+			pending |= e[c];
+		}
+	}
 }
 
-long double rhs(int j) {
+static inline __attribute__((always_inline))
+void chunkLeft(uint64_t d, int m, int j, int l, int coef,
+               int shift, int powBits, int power,
+               uint64_t bound, uint64_t k0, int size, long double* terms) {
+
+	uint64_t r[CHUNK], exp[CHUNK], base[CHUNK], factor[CHUNK], temp[CHUNK];
+	long double rf[CHUNK], inverse[CHUNK];
+
+	// Only k Below The Term Bound
+	if (k0 >= bound)
+		return;
+
+	if (bound - k0 < (uint64_t) size)
+		size = bound - k0;
+
+	// Lanes Past The Size Too, They Pad The Interleaved Exponentiation
+	for (int c = 0; c < CHUNK; c++) {
+		r[c] = m * (k0 + c) + j;
+
+		if (power > 1)
+			r[c] *= m * (k0 + c) + j;
+
+		// r < 2^63 Below Bound, Signed Conversion is a Single Instruction
+		rf[c] = (int64_t) r[c];
+	}
+
+	batchInverse(rf, inverse, size);
+
+	// Barrett is Exact and Fastest While Products Stay Small, Moduli
+	// Grow With k, so Only Lanes After The First Can Need Montgomery
+	if (!(r[0] >> FAST_BITS)) {
+		for (int c = 0; c < CHUNK; c++) {
+			bool fast = c < size && !(r[c] >> FAST_BITS);
+
+			exp[c] = fast ? (4 * d + l - shift * (k0 + c)) >>
+			                __builtin_ctz(powBits) : 0;
+			base[c] = fast ? r[c] : r[0];
+			factor[c] = barrettFactor(base[c], inverse[fast ? c : 0]);
+		}
+
+		chunkPowBarret(1 << powBits, exp, base, factor, temp);
+	}
+
+	for (int c = 0; c < size; c++) {
+		if (r[c] >> FAST_BITS)
+			temp[c] = modPow2MontInv(4 * d + l - shift * (k0 + c),
+			                         r[c], inverse[c]);
+
+		terms[c] += (coef * (long double) (int64_t) temp[c]) * inverse[c];
+	}
+}
+
+static inline __attribute__((always_inline))
+long double termRightSum(uint64_t d, int m, int j, int l, int coef,
+                         int shift, int power,
+                         const char* signs, int period, int bits) {
 	
 	long double sum = 0.0L, temp, r;
-    long double mult = -1.0;
-
-	if (j == 1)
-		mult = 4.0L;
-	else if (j == 4)
-		mult = -2.0L;
-
-	for (uint64_t k = upperBound; k <= upperBound + 100; k++) {
-		r = 8.0L*k + j;
-		temp = powl(16.0L, (long double) upperBound - k) / r;
-		
-		if (temp < EPSILON)
-			break;
+	uint64_t bound = termBound(d, l, shift);
+	uint64_t length = tailLength(d, m, j, l, coef, shift, power, bits, NULL);
+
+	for (uint64_t k = bound; k < bound + length; k++) {
+		r = (long double) m * k + j;
 
-		sum += mult * temp;
+		if (power > 1)
+			r *= r;
+
+		temp = ldexpl(1.0L, (int64_t) (4 * d + l - shift * k)) / r;
+		temp *= coef;
+		sum += negativeAt(signs, period, k) ? -temp : temp;
 	    sum = fmodl(sum, 1.0L);
 	}
+
+	return sum;
+}
+
 	
+BUILTIN_FORMULAS(DEFINE_FORMULA)
+
+static const Kernels builtinKernels[TOTAL_BUILTIN] = {
+	BUILTIN_FORMULAS(KERNELS_ENTRY)
+};
+
+static const char* kernelNames[TOTAL_KERNELS] = {"auto", "generic", "wide"};
+static const char* pinningNames[TOTAL_PINNINGS] = {"none", "cores", "cpus"};
+static const char* schedulerNames[TOTAL_SCHEDULERS] = {"weighted", "equal", "static"};
+
+
+uint64_t genericBound(const BBPJob* job) {
+
+	uint64_t bound = 0;
+
+	for (int i = 0; i < job -> formula -> totalTerms; i++)
+		if (job -> termBounds[i] > bound)
+			bound = job -> termBounds[i];
+
+	return bound;
+}
+
+long double genericLfS(const BBPJob* job, uint64_t s) {
+
+	const Formula* formula = job -> formula;
+	const Term* terms = formula -> terms;
+	int period = strlen(formula -> signs), phase = s % period;
+	long double sum = 0.0L, chunk[CHUNK];
+	uint64_t loopLimit = s + job -> batchSize;
+
+	if (loopLimit > job -> upperBound)
+		loopLimit = job -> upperBound;
+
+	for (uint64_t k0 = s; k0 < loopLimit; k0 += CHUNK) {
+		const int size = (loopLimit - k0 < CHUNK) ? loopLimit - k0 : CHUNK;
+
+		for (int c = 0; c < size; c++)
+			chunk[c] = 0.0L;
+
+		for (int i = 0; i < formula -> totalTerms; i++)
+			chunkLeft(job -> d, terms[i].m, terms[i].j, terms[i].l,
+			          terms[i].coef, formula -> shift, formula -> powBits,
+			          formula -> power, job -> termBounds[i], k0, size, chunk);
+
+		// Sign Phase Kept as a Counter, No Divide Per k
+		for (int c = 0; c < size; c++) {
+			sum += (formula -> signs[phase] == '-') ? -chunk[c] : chunk[c];
+			sum = fmodl(sum, 1.0L);
+
+			if (++phase == period)
+				phase = 0;
+		}
+	}
+
 	return sum;
 }
 
+long double wideLfS(const BBPJob* job, uint64_t s) {
+
+	const Formula* formula = job -> formula;
+	const Term* terms = formula -> terms;
+	int period = strlen(formula -> signs), phase = s % period;
+	long double sum = 0.0L, chunk[CHUNK], rf[CHUNK], inverse[CHUNK];
+	uint64_t loopLimit = s + job -> batchSize;
+
+	if (loopLimit > job -> upperBound)
+		loopLimit = job -> upperBound;
+
+	for (uint64_t k0 = s; k0 < loopLimit; k0 += CHUNK) {
+		const int size = (loopLimit - k0 < CHUNK) ? loopLimit - k0 : CHUNK;
+
+		for (int c = 0; c < size; c++)
+			chunk[c] = 0.0L;
+
+		for (int i = 0; i < formula -> totalTerms; i++) {
+			int count = size;
+
+			// Only k Below The Term Bound
+			if (k0 >= job -> termBounds[i])
+				continue;
+
+			if (job -> termBounds[i] - k0 < (uint64_t) count)
+				count = job -> termBounds[i] - k0;
+
+			for (int c = 0; c < count; c++) {
+				rf[c] = (long double) terms[i].m * (k0 + c) + terms[i].j;
+
+				if (formula -> power > 1)
+					rf[c] *= rf[c];
+			}
+
+			batchInverse(rf, inverse, count);
+
+			for (int c = 0; c < count; c++) {
+				const uint64_t k = k0 + c;
+				__uint128_t r, exp, temp;
+
+				// Positive Since k is Below The Term Bound
+				r = (__uint128_t) terms[i].m * k + terms[i].j;
+				exp = (__uint128_t) 4 * job -> d + terms[i].l -
+				      (__uint128_t) formula -> shift * k;
+
+				if (formula -> power > 1)
+					r *= r;
+
+				// Halves Converted Inline, Avoids a Library Call Per Term
+				temp = modPow2Wide(exp, r);
+				chunk[c] += terms[i].coef * inverse[c] *
+				            ((uint64_t) (temp >> 64) * 0x1p64L + (uint64_t) temp);
+			}
+		}
+
+		for (int c = 0; c < size; c++) {
+			sum += (formula -> signs[phase] == '-') ? -chunk[c] : chunk[c];
+			sum = fmodl(sum, 1.0L);
+
+			if (++phase == period)
+				phase = 0;
+		}
+	}
+
+	return sum;
+}
+
+long double genericRfS(const BBPJob* job) {
+
+	const Formula* formula = job -> formula;
+	const Term* terms = formula -> terms;
+	int period = strlen(formula -> signs);
+	long double result = 0.0L;
+
+	for (int i = 0; i < formula -> totalTerms; i++)
+		result += termRightSum(job -> d, terms[i].m, terms[i].j, terms[i].l,
+		                       terms[i].coef, formula -> shift,
+		                       formula -> power, formula -> signs, period,
+		                       4 * job -> digits + TAIL_GUARD);
+
+	return fmodl(result, 1.0L);
+}
+
+
+uint64_t batchesToTake(const BBPJob* job, const WorkerSlot* slot) {
+
+	uint64_t weight = slot -> weight, share;
+	uint64_t left = (job -> upperBound - job -> count + job -> batchSize - 1) / job -> batchSize;
+	double slowest = 0.0;
+
+	if (slot -> batchTime > 0.0) {
+		for (int i = 0; i < job -> activeThreads; i++)
+			if (job -> slots[i].batchTime > slowest)
+				slowest = job -> slots[i].batchTime;
+
+		weight = lround(slowest / slot -> batchTime);
+	}
+
+	share = (left + job -> activeThreads - 1) / job -> activeThreads;
+
+	if (weight > MAX_WEIGHT)
+		weight = MAX_WEIGHT;
+
+	if (weight > share)
+		weight = share;
+
+	return (weight) ? weight : 1;
+}
+
 void* thPool(void* arg) {
   
+	WorkerSlot* slot = (WorkerSlot*) arg;
+	BBPJob* job = slot -> job;
+	__uint128_t sum = 0;
+	double spent = 0.0;
+	bool measure = job -> activeThreads > 1;
+  
 	while (true) {
-		uint64_t localCount;
-		int localIndex;
+		uint64_t localCount, batches, ran = 0;
+		double start;
       
-		pthread_mutex_lock(&counterMutex);
-		if (count >= upperBound) {
-			pthread_mutex_unlock(&counterMutex);
+		pthread_mutex_lock(&job -> counterMutex);
+
+		// Time of Last Batches Published Here, Under The Lock
+		if (spent > 0.0)
+			slot -> batchTime = (slot -> batchTime > 0.0) ?
+			                    0.75 * slot -> batchTime + 0.25 * spent : spent;
+
+		if (job -> count >= job -> upperBound || job -> stop) {
+			pthread_mutex_unlock(&job -> counterMutex);
 			break;
 		}
 
-		localCount = count;
-		count += batchSize;
+		batches = (measure && job -> scheduler == SCHED_WEIGHTED) ?
+		          batchesToTake(job, slot) : 1;
+		localCount = job -> count;
+		job -> count += batches * job -> batchSize;
                 
-		pthread_mutex_unlock(&counterMutex);
+		pthread_mutex_unlock(&job -> counterMutex);
 
-		pthread_mutex_lock(&accIndexMutex);
-		localIndex = accIndex;
-		accIndex = (accIndex + 1) % TOTAL_ACC;
-		pthread_mutex_unlock(&accIndexMutex);
-                
-		pthread_mutex_lock(accMutex + localIndex);
-		acc[localIndex] += leftSum(localCount);	
-		pthread_mutex_unlock(accMutex + localIndex);
+		start = (measure) ? threadNow() : 0.0;
+
+		// Batches Keep Their Boundaries, so Results Don't Depend on Who
+		// Took Them. Wraps Around Modulo 1. A Stop Leaves The Rest Unrun
+		for (; ran < batches && localCount < job -> upperBound && !job -> stop; ran++) {
+			sum += runBatch(job, localCount);
+			localCount += job -> batchSize;
+		}
+
+		if (measure && ran)
+			spent = (threadNow() - start) / ran;
 	}
+
+	// Slot is Only Written Once, When The Worker Finishes
+	slot -> sum = sum;
 	
 	return NULL;
 }
 
-void initThreads() {
+void* staticPool(void* arg) {
 
-	pthread_t producers[activeThreads];
-  
-	pthread_mutex_init(&counterMutex, NULL);
-	pthread_mutex_init(&accIndexMutex, NULL);
-        
-	for (int i = 0; i < TOTAL_ACC; i++)
-		pthread_mutex_init(accMutex + i, NULL);	
-			    
-	// Produce Threads
-    for (int i = 0; i < activeThreads; i++) {
-		if (pthread_create(producers + i, NULL, &thPool, NULL) != 0) {
-			unexpectedError("Error Creating Threads!");
-		}
-	}
+	WorkerSlot* slot = (WorkerSlot*) arg;
+	BBPJob* job = slot -> job;
+	uint64_t stride = job -> activeThreads * job -> batchSize;
+	uint64_t s = (slot - job -> slots) * job -> batchSize, covered = 0;
+	__uint128_t sum = 0;
 
-	// Join Threads
-	for (int i = 0; i < activeThreads; i++) {
-		if (pthread_join(producers[i], NULL) != 0) {
-			unexpectedError("Error Joining Threads!");
-		}
+	for (; s < job -> upperBound && !job -> stop; s += stride) {
+		sum += runBatch(job, s);
+		covered += (job -> upperBound - s < job -> batchSize) ?
+		           job -> upperBound - s : job -> batchSize;
 	}
 
-	pthread_mutex_destroy(&counterMutex);
-	pthread_mutex_destroy(&accIndexMutex);
-        
-	for (int i = 0; i < TOTAL_ACC; i++)
-		pthread_mutex_destroy(accMutex + i);
+	pthread_mutex_lock(&job -> counterMutex);
+	job -> count += covered;
+	pthread_mutex_unlock(&job -> counterMutex);
+
+	slot -> sum = sum;
+
+	return NULL;
 }
 
+void initThreads(BBPJob* job) {
 
-long double bbpAlgoOriginalLfS(uint64_t s) {
+	pthread_t producers[job -> activeThreads];
+	void* (*worker) (void*) = (job -> scheduler == SCHED_STATIC) ? staticPool : thPool;
+  
+	pthread_mutex_init(&job -> counterMutex, NULL);
 
-	long double result;
+	if (job -> activeThreads == 1) {
+		worker(job -> slots);
+	} else {
 
-	result = lhs(1, s);
-	result += lhs(4, s);
-	result += lhs(5, s);
-	result += lhs(6, s);
+		// Produce Threads
+		for (int i = 0; i < job -> activeThreads; i++) {
+			pthread_attr_t attr;
 
-	return result;
+			pthread_attr_init(&attr);
+
+			if (job -> slots[i].cpu >= 0)
+				pinAttribute(&attr, job -> slots[i].cpu);
+
+			if (pthread_create(producers + i, &attr, worker, job -> slots + i) != 0) {
+				unexpectedError("Error Creating Threads!");
+			}
+
+			pthread_attr_destroy(&attr);
+		}
+
+		// Join Threads
+		for (int i = 0; i < job -> activeThreads; i++) {
+			if (pthread_join(producers[i], NULL) != 0) {
+				unexpectedError("Error Joining Threads!");
+			}
+		}
+	}
+
+	pthread_mutex_destroy(&job -> counterMutex);
 }
 
-long double bbpAlgoOriginalRfS() {
 
-    long double result;
+__uint128_t runBatch(const BBPJob* job, uint64_t s) {
+	return toFixed(job -> kernels.left(job, s));
+}
 
-    result = rhs(1);
-	result = fmodl(result, 1.0L);
-	result += rhs(4);
-    result = fmodl(result, 1.0L);
-	result += rhs(5);
-	result = fmodl(result, 1.0L);
-    result += rhs(6);
-	result = fmodl(result, 1.0L);
-        
-	return result;
+long double finishJob(const BBPJob* job, __uint128_t left) {
+	return fmodl(fromFixed(left) + job -> kernels.right(job), 1.0L);
 }
 
+long double errorBound(const BBPJob* job) {
 
-long double lhsBell(int m, int j, int l, uint64_t s, int64_t upperBoundl) {
+	const Formula* formula = job -> formula;
+	long double coefs = 0.0L, left = 0.0L, right = 0.0L, cutOff = 0.0L;
+	uint64_t batches = 0;
 
-	long double r, sum = 0, sign, temp;
-	int64_t loopLimit = s + batchSize;
+	for (int i = 0; i < formula -> totalTerms; i++)
+		coefs += abs(formula -> terms[i].coef);
 
-	if (s >= upperBoundl)
-		return 0;
-        
-	if (loopLimit > upperBoundl)
-		loopLimit = upperBoundl;
-
-	for (uint64_t k = s; k < loopLimit; k++) {
-		sign = (k % 2) ? -1 : 1;
-		r = m * k + j;
-		temp = modPowBarret(2, 4*d + l - 10*k, r);
-		sum += sign * (temp / r);
-	    sum = fmodl(sum, 1.0L);
-	}
+	for (int i = 0; i < formula -> totalTerms; i++) {
+		const Term* term = formula -> terms + i;
+		long double coef = abs(term -> coef);
+		long double r = (long double) term -> m * job -> termBounds[i] + term -> j;
+		long double tail, rest;
+		uint64_t length = tailLength(job -> d, term -> m, term -> j, term -> l,
+		                             term -> coef, formula -> shift, formula -> power,
+		                             4 * job -> digits + TAIL_GUARD, &rest);
 
-	return sum;
-}
+		if (formula -> power > 1)
+			r *= r;
 
-long double bellardLfS(uint64_t s) {
+		// Each Term Below coef, Batched Reciprocal and Products Round
+		left += job -> termBounds[i] * coef * TERM_ULPS;
 
-	long double result = 0;
+		// Right Terms Start Below 2^shift / r and Halve at Least Per k
+		tail = 2 * coef * ldexpl(1.0L, formula -> shift) / r;
+		right += (length + 1) * (1.0L + tail) + tail * TAIL_ULPS;
 
-    result -= lhsBell(4, 1, -1, s, upperBoundNeg1);
-	result -= lhsBell(4, 3, -6, s, upperBoundNeg6);
-	result += lhsBell(10, 1, 2, s, upperBound2);
-	result -= lhsBell(10, 3, 0, s, upperBound0);
-	result -= lhsBell(10, 5, -4, s, upperBoundNeg4);
-	result -= lhsBell(10, 7, -4, s, upperBoundNeg4);
-	result += lhsBell(10, 9, -6, s, upperBoundNeg6);
+		// Terms Past The Length Are Left Out
+		cutOff += rest;
+	}
 
-	fmodl(result, 1.0);
-        
-	return result;
+	// Partial Sums of a k Stay Below coefs, Signed Sums Below 1 + coefs
+	left += job -> upperBound * (formula -> totalTerms * coefs + 1.0L + coefs);
+
+	if (job -> batchSize)
+		batches = (job -> upperBound + job -> batchSize - 1) / job -> batchSize;
+
+	// One Rounding Per Batch (Fixed Point), Back Conversion, Last Sum
+	// and Guard For Rounding of The Bound Itself
+	return ldexpl(left + right + batches + 4, -64) + cutOff;
 }
 
-long double rhsBell(int m, int j, int l, int64_t upperBoundl) {
+uint16_t placeWorkers(WorkerSlot* slots, uint16_t nthreads, PinPolicy pinning) {
 
-	long double r, sum = 0, sign, temp, exp;
+	int cpus[nthreads];
+	uint32_t capacities[nthreads], slowest = FULL_CAPACITY;
+	bool physicalOnly = pinning == PIN_CORES;
+	int chosen;
 
-	for (uint64_t k = upperBoundl; k <= upperBoundl + 100; k++) {
-		sign = (k % 2) ? -1 : 1;
-		r = m * k + j;
-		exp = (long double) 4*d + l - 10* k;
-		temp = powl(2.0, exp);
-		temp = (temp / r) * sign;
+	if (pinning == PIN_NONE || nthreads < 2)
+		return nthreads;
 
-		if (fabsl(temp) < EPSILON)
-			break;
+	chosen = selectCpus(getTopology(), physicalOnly, cpus, capacities, nthreads);
+
+	if (!chosen)
+		return nthreads;
+
+	if (physicalOnly)
+		nthreads = chosen;
 
-		sum += temp;
+	for (int i = 0; i < chosen; i++)
+		if (capacities[i] && capacities[i] < slowest)
+			slowest = capacities[i];
+
+	for (int i = 0; i < nthreads; i++) {
+		slots[i].cpu = cpus[i % chosen];
+		slots[i].weight = (capacities[i % chosen] + slowest / 2) / slowest;
 	}
 
-	sum = fmodl(sum, 1.0L);		
-        
-	return sum;
+	return nthreads;
 }
 
-long double bellardRfs() {
+long double bbpAlgo(BBPJob* job, BBPStats* stats) { 
 
 	long double result = 0;
-	
-    result -= rhsBell(4, 1, -1, upperBoundNeg1);
-	result -= rhsBell(4, 3, -6, upperBoundNeg6);
-	result += rhsBell(10, 1, 2, upperBound2);
-	result -= rhsBell(10, 3, 0, upperBound0);
-	result -= rhsBell(10, 5, -4, upperBoundNeg4);
-	result -= rhsBell(10, 7, -4, upperBoundNeg4);
-	result += rhsBell(10, 9, -6, upperBoundNeg6);
-
-	fmodl(result, 1.0L);
-        
-	return result;	
-}
+	double start = now(), middle;
+	uint16_t nthreads = job -> activeThreads;
 
+	job -> slots = (WorkerSlot*) aligned_alloc(ACC_ALIGN, nthreads * sizeof(WorkerSlot));
+	checkNullPointer((void*) job -> slots);
 
-long double bbpAlgo() { 
+	for (int i = 0; i < nthreads; i++)
+		job -> slots[i] = (WorkerSlot) {.sum = 0, .job = job, .cpu = -1, .weight = 1};
 
-	long double result = 0;
+	// Jobs Sharing The Machine Get Their Own Slice of CPUs
+	if (job -> places) {
+		for (int i = 0; i < nthreads; i++) {
+			job -> slots[i].cpu = job -> places[i].cpu;
+			job -> slots[i].weight = job -> places[i].weight;
+		}
+	} else {
+		nthreads = job -> activeThreads = placeWorkers(job -> slots, nthreads, job -> pinning);
+	}
 
-	initThreads();
-        
-	for (int i = 0; i < TOTAL_ACC; i++)
-		result += acc[i];
+	initThreads(job);
+
+	// Pairwise Reduction, Exact in Fixed Point
+	for (int step = 1; step < nthreads; step *= 2)
+		for (int i = 0; i + step < nthreads; i += 2 * step)
+			job -> slots[i].sum += job -> slots[i + step].sum;
+
+	middle = now();
+
+	result = finishJob(job, job -> slots[0].sum);
+	free(job -> slots);
 
-	result += rightSum();
-	fmodl(result, 1.0L);	
+	if (stats) {
+		stats -> batchSize = job -> batchSize;
+		stats -> terms = 0;
+
+		for (int i = 0; i < job -> formula -> totalTerms; i++)
+			stats -> terms += job -> termBounds[i];
+
+		stats -> leftTime = middle - start;
+		stats -> rightTime = now() - middle;
+		stats -> totalTime = stats -> leftTime + stats -> rightTime;
+		stats -> queueTime = 0.0;
+		stats -> errorBound = errorBound(job);
+		stats -> guaranteedDigits = guaranteedDigits(result, stats -> errorBound,
+		                                             MAX_DIGITS);
+	}
         
 	return result;
 }
 
 
-void ihex (long double x) {
-	int i;
-	long double y;
-	char hx[] = "0123456789ABCDEF";
-	
-	y = x;
+int wideNeeded(const BBPJob* job) {
+
+	const Formula* formula = job -> formula;
+	int wide = 0;
+
+	for (int i = 0; i < formula -> totalTerms; i++) {
+		const Term* term = formula -> terms + i;
+		__uint128_t r = (__uint128_t) term -> m * job -> termBounds[i] + term -> j;
+
+		// Bound Was Clamped, k Wouldn't Fit a Counter
+		if (job -> termBounds[i] == UINT64_MAX)
+			return -1;
+
+		if (formula -> power > 1) {
+
+			if (r >> 63)
+				return -1;
 
-	for (i = 0; i < PRECISION; i++){
-		y = 16. * (y - floor (y));
-		printf("%c", hx[(int) y]);
+			r *= r;
+		}
+
+		if (r >> WIDE_MAX_BITS)
+			return -1;
+
+		if (r >> MONT_MAX_BITS)
+			wide = 1;
 	}
+
+	// Exponent 4d + l Computed in 64 Bits by The Fast Kernels
+	if (job -> d >> (MONT_MAX_BITS - 3))
+		wide = 1;
+
+#ifdef FORCE_WIDE
+	wide = 1;
+#endif
+
+	return wide;
 }
 
+int initJob(BBPJob* job, Config* configs) {
 
-void configAlgorithm() {
+	const Formula* formula = getFormula(configs -> algo);
 
-	int64_t helper = 4 * d;
-  
-	switch (algoInUse) {
+	if (!formula)
+		return 1;
 
-        case BBP_ORIGINAL:
-			leftSum = bbpAlgoOriginalLfS;
-			rightSum = bbpAlgoOriginalRfS;
-			upperBound = d;
-			break;
+	memset(job, 0, sizeof(BBPJob));
 
-        case BELLARD:
-			leftSum = bellardLfS;
-			rightSum = bellardRfs;
+	job -> formula = formula;
+	job -> d = configs -> startPos;
+	job -> activeThreads = (configs -> nthreads) ? configs -> nthreads : 1;
+	job -> digits = (configs -> digits) ? configs -> digits : PRECISION;
+	job -> pinning = configs -> pinning;
+	job -> scheduler = configs -> scheduler;
 
-			helper = 4 * d;
+	if (job -> digits > MAX_DIGITS)
+		job -> digits = MAX_DIGITS;
+	job -> kernels = (Kernels) {genericLfS, genericRfS, genericBound};
 
-			upperBound0 = (int64_t) helper / 10;
-			upperBound2 = (int64_t) (helper + 2) / 10;
-			upperBoundNeg1 = (int64_t )(helper - 1) / 10;
-            upperBoundNeg4 = (int64_t) (helper - 4) / 10;
-            upperBoundNeg6 = (int64_t) (helper - 6) / 10;
-			upperBound = upperBound2;
-            break;
+	for (int i = 0; i < formula -> totalTerms; i++)
+		job -> termBounds[i] = termBound(job -> d, formula -> terms[i].l,
+		                                 formula -> shift);
+
+	// Built-in Formulas Have Kernels Specialized at Compile Time
+	if (configs -> algo < TOTAL_BUILTIN && configs -> kernel != KERNEL_GENERIC)
+		job -> kernels = builtinKernels[configs -> algo];
+
+	job -> upperBound = job -> kernels.bound(job);
+	job -> batchSize = (configs -> batchSize) ? configs -> batchSize : BATCH_SIZE;
+
+	switch (wideNeeded(job)) {
+		case -1:
+			return 1;
+		case 0:
+			if (configs -> kernel != KERNEL_WIDE)
+				break;
+			// Fall Through
+		case 1:
+			job -> kernels.left = wideLfS;
+			job -> wide = true;
+			break;
 	}
   
-	if (upperBound < batchSize)
-		batchSize = upperBound;
+	if (job -> upperBound < job -> batchSize)
+		job -> batchSize = job -> upperBound;
+
+	return 0;
 }
 
 
-void resetVariables() {
+long double evalBBP(Config* currConfigs, BBPStats* stats) {
 
-	for (int i = 0; i < TOTAL_ACC; i++) {
-        acc[i] = 0;
-    }
+	BBPJob job;
 
-	total = NULL;
+	if (initJob(&job, currConfigs)) {
+		invalidArgumentException("Algorithm Not Found or Offset Too Large For Formula!");
+		return NAN;
+	}
     
-    accIndex = 0;
-    count = 0;
+	return bbpAlgo(&job, stats);
 }
 
 
-void calcBBP(Config* currConfigs) {
+int calcBBP(Config* currConfigs) {
 
 	long double result;
-
-	resetVariables();
-        
-	d = currConfigs -> startPos;
-    activeThreads = currConfigs -> nthreads;
-    algoInUse = currConfigs->algo;
-    configAlgorithm();
+	uint8_t bytes[FRACTION_BYTES];
+	char digits[MAX_DIGITS + 1];
+	int precision = (currConfigs -> digits) ? currConfigs -> digits : PRECISION;
+	BBPStats stats;
+	MyTimer* total = NULL;
     
 #ifdef DEBUG
-    printf("\nStarting Position: %ld\n", d);
-	printf("Threads: %d\n", activeThreads);
-	printf("User Algo: %s\n\n", (algoInUse == BBP_ORIGINAL) ? "BBP-Original" : "Bellard");
+    printf("\nStarting Position: %lu\n", currConfigs -> startPos);
+	printf("Threads: %d\n", currConfigs -> nthreads);
+	printf("User Algo: %s\n\n", getFormula(currConfigs -> algo) -> description);
 #endif
 
 	INIT_TIMER(total);
     
-	result = bbpAlgo();
-	printf("\n%d digits @ %ld = ", PRECISION, d);
-	ihex(result);
-	puts("");
+	result = evalBBP(currConfigs, &stats);
+
+	if (isnan(result)) {
+		free(total);
+		return 1;
+	}
+
+	if (precision > MAX_DIGITS)
+		precision = MAX_DIGITS;
+
+	packFraction(result, bytes, (precision + 1) / 2);
+	formatDigits(bytes, precision * 4, DIGITS_HEX, digits, sizeof(digits));
+
+	if (stats.guaranteedDigits > precision)
+		stats.guaranteedDigits = precision;
 
 	END_TIMER(total);
 	CALC_FINAL_TIME(total);
 
+	// Structured Records Are Printed Alone, So They Can be Parsed
+	if (currConfigs -> report != REPORT_TEXT) {
+		stats.totalTime = total -> totalTime;
+		printReport(stdout, currConfigs, &stats, digits);
+		free(total);
+		return 0;
+	}
+
+	// Digits Beyond The Error Bound Are Shown in Brackets
+	if (stats.guaranteedDigits < precision)
+		printf("\n%d digits @ %lu = %.*s[%s]\n", precision, currConfigs -> startPos,
+		       stats.guaranteedDigits, digits, digits + stats.guaranteedDigits);
+	else
+		printf("\n%d digits @ %lu = %s\n", precision, currConfigs -> startPos, digits);
+
+	printf("Guaranteed: %d Digits (Error < %.2Le)\n", stats.guaranteedDigits,
+	       stats.errorBound);
     printf("Total Exec. Time: %.5fs\n", total -> totalTime);
 	free(total);
+
+	return 0;
+}
+
+const char* kernelName(KernelMode kernel) {
+	return (kernel < TOTAL_KERNELS) ? kernelNames[kernel] : NULL;
+}
+
+const char* pinningName(PinPolicy pinning) {
+	return (pinning < TOTAL_PINNINGS) ? pinningNames[pinning] : NULL;
+}
+
+const char* schedulerName(SchedulerMode scheduler) {
+	return (scheduler < TOTAL_SCHEDULERS) ? schedulerNames[scheduler] : NULL;
+}
+
+int parseKernel(const char* name, KernelMode* kernel) {
+
+	for (int i = 0; i < TOTAL_KERNELS; i++) {
+		if (!strcmp(name, kernelNames[i])) {
+			*kernel = (KernelMode) i;
+			return 0;
+		}
+	}
+
+	return 1;
+}
+
+int parsePinning(const char* name, PinPolicy* pinning) {
+
+	for (int i = 0; i < TOTAL_PINNINGS; i++) {
+		if (!strcmp(name, pinningNames[i])) {
+			*pinning = (PinPolicy) i;
+			return 0;
+		}
+	}
+
+	return 1;
+}
+
+int parseScheduler(const char* name, SchedulerMode* scheduler) {
+
+	for (int i = 0; i < TOTAL_SCHEDULERS; i++) {
+		if (!strcmp(name, schedulerNames[i])) {
+			*scheduler = (SchedulerMode) i;
+			return 0;
+		}
+	}
+
+	return 1;
 }
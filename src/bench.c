@@ -0,0 +1,221 @@
+/*-----------------------------------------------------------------*/
+/**
+  @file   bench.c
+  @author Flávio M.
+  @brief  Microbenchmarks of Modular Arithmetic Primitives.
+ */
+/*-----------------------------------------------------------------*/
+
+/*-----------------------------------------------------------------
+                              Includes
+  -----------------------------------------------------------------*/
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+#include "../include/bbp.h"
+#include "../include/bench.h"
+#include "../include/modular.h"
+
+
+/*-----------------------------------------------------------------
+                            Definitions
+-----------------------------------------------------------------*/
+#define MIN_OPS 1024          // Operations in First Run of a Case
+#define MIN_SECONDS 0.05      // Operations Double Until a Run Takes This Long
+#define CHAINS 4              // Independent Chains in Throughput Runs
+#define TOTAL_RUNS 3          // Runs Per Case, Fastest is Reported
+
+
+/*-----------------------------------------------------------------
+                          Structs and Enums
+-----------------------------------------------------------------*/
+
+// Primitives Benchmarked
+typedef enum {
+	BENCH_REDUCE,
+	BENCH_MUL,
+	BENCH_POW,
+	BENCH_MONT,
+	BENCH_WIDE,
+	TOTAL_PRIMITIVES
+}Primitive;
+
+// Access Patterns
+typedef enum {
+	LATENCY,      // Each Op Depends on The Previous One
+	THROUGHPUT,   // CHAINS Independent Ops in Flight
+	TOTAL_PATTERNS
+}Pattern;
+
+
+/*-----------------------------------------------------------------
+                          Global Variables
+-----------------------------------------------------------------*/
+static const char* primitiveNames[] = {"barretReduction", "modMul", "modPowBarret",
+                                       "modPow2Mont", "modPow2Wide"};
+static const char* patternNames[] = {"latency", "throughput"};
+
+// Results Are Accumulated Here so The Loops Can't be Removed
+static volatile uint64_t sink;
+
+
+/*-----------------------------------------------------------------
+                   Internal Functions Signatures
+  -----------------------------------------------------------------*/
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Run a Primitive Once in a Pattern.
+   @param  Primitive Primitive to be Measured.
+   @param  Pattern   Dependent or Independent Chains.
+   @param  uint64_t  Offset (d), Sets Modulus and Exponent Sizes.
+   @param  uint64_t  Number of Operations (Multiple of CHAINS).
+   @return double    Seconds Elapsed.
+*/
+/*-----------------------------------------------------------------*/
+double benchRun(Primitive, Pattern, uint64_t, uint64_t);
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Current Time of a Monotonic Clock.
+   @return double Time in Seconds.
+*/
+/*-----------------------------------------------------------------*/
+static inline double benchNow();
+
+
+/*-----------------------------------------------------------------
+                      Functions Implementation
+  -----------------------------------------------------------------*/
+static inline double benchNow() {
+
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC_RAW, &ts);
+
+	return ts.tv_sec + ts.tv_nsec / 1000000000.0;
+}
+
+double benchRun(Primitive primitive, Pattern pattern, uint64_t d, uint64_t ops) {
+
+	// Largest Denominator of Bellard's Formula at This Offset (10k + 9)
+	const uint64_t base = 4 * d + 9;
+	const uint64_t factor = UINT64_MAX / base;
+	uint64_t x[CHAINS];
+	double start;
+
+	for (int c = 0; c < CHAINS; c++)
+		x[c] = (base / (c + 2)) | 1;
+
+	start = benchNow();
+
+	if (pattern == LATENCY) {
+		uint64_t y = x[0];
+
+		for (uint64_t i = 0; i < ops; i++) {
+			switch (primitive) {
+				case BENCH_REDUCE:
+					y = barretReduction((__uint128_t) y * x[1], base, factor);
+					break;
+				case BENCH_MUL:
+					y = modMul(y, x[1], base, factor);
+					break;
+				case BENCH_POW:
+					// Exponent Depends on Last Result, as 4d - shift*k Does on k
+					y = modPowBarret(16, d - (y & 1023), base - (i & 1023));
+					break;
+				case BENCH_MONT:
+					y = modPow2Mont(4 * d - (y & 1023), base - (i & 1023));
+					break;
+				default:
+					y = modPow2Wide(4 * d - (y & 1023), base - (i & 1023));
+					break;
+			}
+		}
+
+		sink += y;
+
+		return benchNow() - start;
+	}
+
+	for (uint64_t i = 0; i < ops; i += CHAINS) {
+		switch (primitive) {
+			case BENCH_REDUCE:
+				for (int c = 0; c < CHAINS; c++)
+					x[c] = barretReduction((__uint128_t) x[c] * x[c], base, factor);
+				break;
+			case BENCH_MUL:
+				for (int c = 0; c < CHAINS; c++)
+					x[c] = modMul(x[c], x[c], base, factor);
+				break;
+			case BENCH_POW:
+				for (int c = 0; c < CHAINS; c++)
+					sink += modPowBarret(16, d - c, base - ((i + c) & 1023));
+				break;
+			case BENCH_MONT:
+				for (int c = 0; c < CHAINS; c++)
+					sink += modPow2Mont(4 * d - c, base - ((i + c) & 1023));
+				break;
+			default:
+				for (int c = 0; c < CHAINS; c++)
+					sink += modPow2Wide(4 * d - c, base - ((i + c) & 1023));
+				break;
+		}
+	}
+
+	for (int c = 0; c < CHAINS; c++)
+		sink += x[c];
+
+	return benchNow() - start;
+}
+
+void runBench(ReportFormat report) {
+
+	static const uint64_t offsets[] = {
+		1000000ULL, 100000000ULL, 10000000000ULL, 1000000000000ULL
+	};
+
+	if (report == REPORT_CSV)
+		printf("primitive,pattern,offset,modulusBits,nsPerOp,mopsPerSec\n");
+	else if (report == REPORT_TEXT)
+		printf("\n%-16s %-11s %14s %5s %10s %10s\n", "Primitive", "Pattern",
+		       "Offset", "Bits", "ns/op", "Mops/s");
+
+	for (int p = 0; p < TOTAL_PRIMITIVES; p++) {
+		for (int a = 0; a < TOTAL_PATTERNS; a++) {
+			for (size_t o = 0; o < sizeof(offsets) / sizeof(uint64_t); o++) {
+				uint64_t d = offsets[o], ops = MIN_OPS;
+				int bits = 64 - __builtin_clzll(4 * d + 9);
+				double best, nsPerOp;
+
+				// Slow Primitives (Large Moduli) Run Fewer Operations
+				while ((best = benchRun(p, a, d, ops)) < MIN_SECONDS)
+					ops *= 2;
+
+				// Fastest of Some Runs, Less Noise From The Machine
+				for (int r = 1; r < TOTAL_RUNS; r++) {
+					double elapsed = benchRun(p, a, d, ops);
+
+					if (elapsed < best)
+						best = elapsed;
+				}
+
+				nsPerOp = best * 1e9 / ops;
+
+				if (report == REPORT_CSV)
+					printf("%s,%s,%lu,%d,%.3f,%.3f\n", primitiveNames[p],
+					       patternNames[a], d, bits, nsPerOp, 1e3 / nsPerOp);
+				else if (report == REPORT_JSON)
+					printf("{\"primitive\":\"%s\",\"pattern\":\"%s\",\"offset\":%lu,"
+					       "\"modulusBits\":%d,\"nsPerOp\":%.3f,\"mopsPerSec\":%.3f}\n",
+					       primitiveNames[p], patternNames[a], d, bits,
+					       nsPerOp, 1e3 / nsPerOp);
+				else
+					printf("%-16s %-11s %14lu %5d %10.3f %10.3f\n",
+					       primitiveNames[p], patternNames[a], d, bits,
+					       nsPerOp, 1e3 / nsPerOp);
+			}
+		}
+	}
+}
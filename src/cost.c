@@ -0,0 +1,496 @@
+/*-----------------------------------------------------------------*/
+/**
+  @file   cost.c
+  @author Flávio M.
+  @brief  Runtime Model Calibrated From Probes on The Host.
+ */
+/*-----------------------------------------------------------------*/
+
+/*-----------------------------------------------------------------
+                              Includes
+  -----------------------------------------------------------------*/
+#include <math.h>
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "../include/bbp.h"
+#include "../include/cost.h"
+#include "../include/error-handler.h"
+#include "../include/formula.h"
+#include "../include/job.h"
+#include "../include/topology.h"
+
+
+/*-----------------------------------------------------------------
+                            Definitions
+-----------------------------------------------------------------*/
+#define PROBE_SECONDS 2e-4     // Min Duration of a Timed Probe
+#define PROBE_ROUNDS 3         // Best Of Rounds, Filters Interruptions
+#define THREAD_PROBES 16       // Threads Created to Time Their Cost
+#define LOCK_PROBES 100000     // Lock Pairs Timed (Cost Per Batch)
+#define PROBE_BATCHES 16       // Consecutive Batches in a Probe
+
+
+/*-----------------------------------------------------------------
+                          Structs and Enums
+-----------------------------------------------------------------*/
+
+// Modular Exponentiation Used For a Term
+typedef enum {
+	PATH_BARRETT,    // Modulus Below 2^FAST_BITS
+	PATH_MONT,       // 64-Bit Montgomery
+	PATH_WIDE,       // 128-Bit Montgomery (Whole Job)
+	TOTAL_PATHS
+}CostPath;
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief Fitted Model of an Algorithm. Seconds Per Term Evaluation
+          = a + b * log2(Exponent), For Each Path.
+*/
+/*-----------------------------------------------------------------*/
+typedef struct {
+	bool calibrated;
+	bool fitted[TOTAL_PATHS];
+	double a[TOTAL_PATHS];
+	double b[TOTAL_PATHS];
+	double rightTime;          // Seconds of Right Summation
+} CostModel;
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief Sums of a Least Squares Fit.
+*/
+/*-----------------------------------------------------------------*/
+typedef struct {
+	double n, x, y, xx, xy;
+} Fit;
+
+
+/*-----------------------------------------------------------------
+                          Global Variables
+-----------------------------------------------------------------*/
+static CostModel models[MAX_FORMULAS];
+static double threadTime = -1.0;    // Seconds to Create and Join a Thread
+static double lockTime;             // Seconds of a Lock Pair (Per Batch)
+static pthread_mutex_t modelMutex = PTHREAD_MUTEX_INITIALIZER;
+
+// Offsets (Powers of Two) and Positions (Fraction of Bound) Probed
+static const int probeBits[] = {12, 18, 24, 30, 36, 42, 48, 54, 61};
+static const double probeFractions[] = {0.0, 0.5, 0.9, 0.99, 0.999999};
+
+
+/*-----------------------------------------------------------------
+                   Internal Functions Signatures
+  -----------------------------------------------------------------*/
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Path Used by a Term at k (Jobs Not Using The Wide Kernel).
+   @param  const Term* Term of Formula.
+   @param  int         Power of Denominator.
+   @param  uint64_t    Current Position (k).
+   @return CostPath    Path of Term.
+*/
+/*-----------------------------------------------------------------*/
+CostPath termPath(const Term*, int, uint64_t);
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Describe The Terms Evaluated by Consecutive Batches.
+   @param  const BBPJob* Job Initialized by initJob.
+   @param  uint64_t      First k of Range.
+   @param  uint64_t      Last k of Range (Excluded).
+   @param  double*       Mean log2(Exponent) of Evaluations.
+   @param  uint64_t*     Number of Evaluations.
+   @return int           Path of Every Evaluation / -1 if Mixed.
+*/
+/*-----------------------------------------------------------------*/
+int describeRange(const BBPJob*, uint64_t, uint64_t, double*, uint64_t*);
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Seconds of Consecutive Batches, Best of Several Rounds.
+           Distinct Batches Keep The Branch Predictor From Learning
+           The Exponents, as it Would Repeating a Single One.
+   @param  const BBPJob* Job Initialized by initJob.
+   @param  uint64_t      First k of Range (Multiple of batchSize).
+   @param  uint64_t      Last k of Range (Excluded).
+   @return double        Seconds.
+*/
+/*-----------------------------------------------------------------*/
+double timeRange(const BBPJob*, uint64_t, uint64_t);
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Time Thread Creation and Batch Locking (Once Per Host).
+*/
+/*-----------------------------------------------------------------*/
+void calibrateHost();
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Predicted Seconds of The Evaluations of a Term in [k0, k1).
+   @param  const CostModel* Model of Algorithm.
+   @param  CostPath         Path of Evaluations.
+   @param  long double      Exponent at k1 - 1/2.
+   @param  int              Exponent Decrease Per k (shift).
+   @param  uint64_t         Number of Evaluations (k1 - k0).
+   @return double           Seconds.
+*/
+/*-----------------------------------------------------------------*/
+double segmentCost(const CostModel*, CostPath, long double, int, uint64_t);
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Empty Thread, Times Creation.
+*/
+/*-----------------------------------------------------------------*/
+void* idleThread(void*);
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Current Time in Seconds (Monotonic).
+   @return double Seconds.
+*/
+/*-----------------------------------------------------------------*/
+static inline double now();
+
+
+/*-----------------------------------------------------------------
+                      Functions Implementation
+  -----------------------------------------------------------------*/
+static inline double now() {
+
+	struct timespec time;
+
+	clock_gettime(CLOCK_MONOTONIC_RAW, &time);
+
+	return time.tv_sec + time.tv_nsec / 1e9;
+}
+
+void* idleThread(void* arg) {
+	return arg;
+}
+
+CostPath termPath(const Term* term, int power, uint64_t k) {
+
+	__uint128_t r = (__uint128_t) term -> m * k + term -> j;
+
+	if (power > 1)
+		r *= r;
+
+	return (r >> FAST_BITS) ? PATH_MONT : PATH_BARRETT;
+}
+
+int describeRange(const BBPJob* job, uint64_t s, uint64_t end,
+                  double* meanBits, uint64_t* evals) {
+
+	const Formula* formula = job -> formula;
+	double bits = 0.0;
+	int path = -1;
+
+	*evals = 0;
+
+	for (int i = 0; i < formula -> totalTerms; i++) {
+		const Term* term = formula -> terms + i;
+		uint64_t last = (end < job -> termBounds[i]) ? end : job -> termBounds[i];
+		int termFirst, termLast;
+
+		if (s >= last)
+			continue;
+
+		termFirst = (job -> wide) ? PATH_WIDE : termPath(term, formula -> power, s);
+		termLast = (job -> wide) ? PATH_WIDE : termPath(term, formula -> power, last - 1);
+
+		// Ranges Crossing a Path Boundary Don't Fit a Single Line
+		if (termFirst != termLast || (path != -1 && termFirst != path))
+			return -1;
+
+		path = termFirst;
+
+		for (uint64_t k = s; k < last; k++)
+			bits += log2(4.0 * job -> d + term -> l - (double) formula -> shift * k);
+
+		*evals += last - s;
+	}
+
+	*meanBits = (*evals) ? bits / *evals : 0.0;
+
+	return path;
+}
+
+double timeRange(const BBPJob* job, uint64_t s, uint64_t end) {
+
+	volatile __uint128_t sink = 0;
+	double best = INFINITY;
+	uint64_t reps = 1;
+
+	for (int round = 0; round < PROBE_ROUNDS; round++) {
+		double start, elapsed;
+
+		// Enough Repetitions For a Measurable Interval (First Round)
+		while (true) {
+			start = now();
+
+			for (uint64_t i = 0; i < reps; i++)
+				for (uint64_t k = s; k < end; k += job -> batchSize)
+					sink += runBatch(job, k);
+
+			elapsed = now() - start;
+
+			if (round || elapsed >= PROBE_SECONDS)
+				break;
+
+			reps *= 2;
+		}
+
+		if (elapsed / reps < best)
+			best = elapsed / reps;
+	}
+
+	(void) sink;
+
+	return best;
+}
+
+void calibrateHost() {
+
+	pthread_mutex_t lock = PTHREAD_MUTEX_INITIALIZER;
+	pthread_t thread;
+	double start;
+
+	start = now();
+
+	for (int i = 0; i < THREAD_PROBES; i++) {
+		if (pthread_create(&thread, NULL, &idleThread, NULL) != 0 ||
+		    pthread_join(thread, NULL) != 0) {
+			unexpectedError("Error Creating Threads!");
+		}
+	}
+
+	threadTime = (now() - start) / THREAD_PROBES;
+
+	start = now();
+
+	for (int i = 0; i < LOCK_PROBES; i++) {
+		pthread_mutex_lock(&lock);
+		pthread_mutex_unlock(&lock);
+	}
+
+	lockTime = (now() - start) / LOCK_PROBES;
+}
+
+int calibrateCost(int algo) {
+
+	const Formula* formula = getFormula(algo);
+	CostModel model;
+	Fit fits[TOTAL_PATHS];
+	BBPJob job;
+	Config configs = {0, 1, algo, REPORT_TEXT};
+
+	if (!formula)
+		return 1;
+
+	pthread_mutex_lock(&modelMutex);
+
+	if (models[algo].calibrated) {
+		pthread_mutex_unlock(&modelMutex);
+		return 0;
+	}
+
+	if (threadTime < 0.0)
+		calibrateHost();
+
+	memset(&model, 0, sizeof(CostModel));
+	memset(fits, 0, sizeof(fits));
+
+	for (size_t i = 0; i < sizeof(probeBits) / sizeof(int); i++) {
+
+		configs.startPos = 1ULL << probeBits[i];
+
+		// Offsets Beyond The Formula Limits Are Skipped
+		if (initJob(&job, &configs) || !job.upperBound)
+			continue;
+
+		if (!model.rightTime) {
+			double start = now();
+			volatile long double right = job.kernels.right(&job);
+
+			(void) right;
+			model.rightTime = now() - start;
+		}
+
+		for (size_t j = 0; j < sizeof(probeFractions) / sizeof(double); j++) {
+			uint64_t s = (uint64_t) (job.upperBound * probeFractions[j]);
+			uint64_t end, evals;
+			double bits, y;
+			int path;
+
+			s -= s % job.batchSize;
+			end = s + PROBE_BATCHES * job.batchSize;
+
+			if (end > job.upperBound || end < s)
+				end = job.upperBound;
+
+			path = describeRange(&job, s, end, &bits, &evals);
+
+			if (path == -1 || !evals)
+				continue;
+
+			y = timeRange(&job, s, end) / evals;
+
+			fits[path].n++;
+			fits[path].x += bits;
+			fits[path].y += y;
+			fits[path].xx += bits * bits;
+			fits[path].xy += bits * y;
+		}
+	}
+
+	for (int p = 0; p < TOTAL_PATHS; p++) {
+		Fit* fit = fits + p;
+		double variance;
+
+		if (!fit -> n)
+			continue;
+
+		variance = fit -> n * fit -> xx - fit -> x * fit -> x;
+		model.fitted[p] = true;
+		model.b[p] = (variance > 1e-9 * fit -> n * fit -> xx) ?
+		             (fit -> n * fit -> xy - fit -> x * fit -> y) / variance : 0.0;
+		model.a[p] = (fit -> y - model.b[p] * fit -> x) / fit -> n;
+	}
+
+	model.calibrated = true;
+	models[algo] = model;
+	pthread_mutex_unlock(&modelMutex);
+
+	return 0;
+}
+
+double segmentCost(const CostModel* model, CostPath path, long double lowExp,
+                   int shift, uint64_t evals) {
+
+	long double span = (long double) shift * evals;
+	long double sumBits;
+
+	// Paths Never Probed Use The Nearest Probed One
+	while (!model -> fitted[path] && path > PATH_BARRETT)
+		path--;
+
+	while (!model -> fitted[path] && path < PATH_WIDE)
+		path++;
+
+	if (!evals || !model -> fitted[path])
+		return 0.0;
+
+	// Sum of log2(Exponent) as an Integral, Accurate For Huge Exponents:
+	// Int ln E dE (E From e To e + span) = span ln e + (e + span) ln(1 + span / e) - span
+	sumBits = (span * logl(lowExp) + (lowExp + span) * log1pl(span / lowExp) - span) /
+	          (shift * M_LN2);
+
+	return model -> a[path] * evals + model -> b[path] * (double) sumBits;
+}
+
+int estimateCost(const Config* currConfigs, uint64_t batchSize, CostEstimate* estimate) {
+
+	Config configs = *currConfigs;
+	const CostModel* model;
+	const Formula* formula;
+	BBPJob job;
+	uint64_t batches;
+	uint16_t parallel;
+	const Topology* machine = getTopology();
+	long cpus = (configs.pinning == PIN_CORES) ? machine -> cores : machine -> total;
+	double left = 0.0, perBatch;
+
+	if (initJob(&job, &configs) || calibrateCost(configs.algo))
+		return 1;
+
+	formula = job.formula;
+	model = models + configs.algo;
+	memset(estimate, 0, sizeof(CostEstimate));
+
+	if (batchSize)
+		job.batchSize = (batchSize < job.upperBound) ? batchSize : job.upperBound;
+
+	for (int i = 0; i < formula -> totalTerms; i++) {
+		const Term* term = formula -> terms + i;
+		uint64_t bound = job.termBounds[i], split = bound;
+		long double exponent = 4.0L * job.d + term -> l;
+
+		if (!bound)
+			continue;
+
+		// First k Whose Modulus Leaves The Barrett Path
+		if (!job.wide) {
+			long double root = powl(2.0L, (long double) FAST_BITS / formula -> power);
+			long double first = ceill((root - term -> j) / term -> m);
+
+			split = (first < 0.0L) ? 0 : (first < bound) ? (uint64_t) first : bound;
+
+			while (split > 0 && termPath(term, formula -> power, split - 1) == PATH_MONT)
+				split--;
+
+			while (split < bound && termPath(term, formula -> power, split) == PATH_BARRETT)
+				split++;
+		}
+
+		// Exponent at k - 1/2 of Last k in Each Segment
+		if (job.wide) {
+			left += segmentCost(model, PATH_WIDE,
+			                    exponent - formula -> shift * (bound - 0.5L),
+			                    formula -> shift, bound);
+		} else {
+			left += segmentCost(model, PATH_BARRETT,
+			                    exponent - formula -> shift * (split - 0.5L),
+			                    formula -> shift, split);
+			left += segmentCost(model, PATH_MONT,
+			                    exponent - formula -> shift * (bound - 0.5L),
+			                    formula -> shift, bound - split);
+		}
+
+		estimate -> terms += bound;
+	}
+
+	batches = (job.batchSize) ? (job.upperBound + job.batchSize - 1) / job.batchSize : 0;
+	parallel = job.activeThreads;
+
+	if (cpus > 0 && parallel > cpus)
+		parallel = cpus;
+
+	if (parallel > batches)
+		parallel = (batches) ? batches : 1;
+
+	perBatch = (batches) ? left / batches : 0.0;
+
+	estimate -> batchSize = job.batchSize;
+	estimate -> parallel = parallel;
+	estimate -> leftTime = left + batches * lockTime;
+	estimate -> rightTime = model -> rightTime;
+
+	// A Single Thread Runs Inline, Without Creating Threads
+	estimate -> threadTime = (job.activeThreads > 1) ? job.activeThreads * threadTime : 0.0;
+
+	// Last Batches Leave Threads Idle, About One Batch
+	estimate -> wallTime = estimate -> leftTime / parallel +
+	                       ((parallel > 1) ? perBatch * (1.0 - 1.0 / parallel) : 0.0) +
+	                       estimate -> rightTime + estimate -> threadTime;
+	estimate -> cpuTime = estimate -> leftTime + estimate -> rightTime;
+
+	return 0;
+}
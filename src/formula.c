@@ -0,0 +1,222 @@
+/*-----------------------------------------------------------------*/
+/**
+  @file   formula.c
+  @author Flávio M.
+  @brief  Registry of BBP-Type Formulas.
+ */
+/*-----------------------------------------------------------------*/
+
+/*-----------------------------------------------------------------
+                              Includes
+  -----------------------------------------------------------------*/
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../include/formula.h"
+
+
+/*-----------------------------------------------------------------
+                            Definitions
+   -----------------------------------------------------------------*/
+#define TERM_ENTRY(m, j, l, coef) {m, j, l, coef},
+
+#define FORMULA_ENTRY(ID, NAME, KEY, DESC, SHIFT, POW_BITS, SIGNS, POWER, TERMS) \
+	{                                                                  \
+		.key = KEY,                                                    \
+		.description = DESC,                                           \
+		.shift = SHIFT,                                                \
+		.powBits = POW_BITS,                                           \
+		.power = POWER,                                                \
+		.signs = SIGNS,                                                \
+		.totalTerms = sizeof((Term[]) {TERMS(TERM_ENTRY)}) / sizeof(Term), \
+		.terms = {TERMS(TERM_ENTRY)}                                   \
+	},
+
+#define COUNT_ENTRY(...) + 1
+
+
+/*-----------------------------------------------------------------
+                          Global Variables
+-----------------------------------------------------------------*/
+static Formula registry[MAX_FORMULAS] = {
+	BUILTIN_FORMULAS(FORMULA_ENTRY)
+};
+
+static uint16_t formulasInUse = 0 BUILTIN_FORMULAS(COUNT_ENTRY);
+
+
+/*-----------------------------------------------------------------
+                   Internal Functions Signatures
+  -----------------------------------------------------------------*/
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Greatest Common Divisor.
+   @param  int a.
+   @param  int b.
+   @return int gcd(|a|, |b|).
+*/
+/*-----------------------------------------------------------------*/
+int gcd(int, int);
+
+
+/*-----------------------------------------------------------------
+                      Functions Implementation
+  -----------------------------------------------------------------*/
+int gcd(int a, int b) {
+
+	a = abs(a);
+	b = abs(b);
+
+	while (b) {
+		int temp = a % b;
+		a = b;
+		b = temp;
+	}
+
+	return a;
+}
+
+const Formula* getFormula(int index) {
+
+	if (index < 0 || index >= formulasInUse)
+		return NULL;
+
+	return registry + index;
+}
+
+int findFormula(const char* key) {
+
+	for (int i = 0; i < formulasInUse; i++)
+		if (!strcmp(registry[i].key, key))
+			return i;
+
+	return -1;
+}
+
+uint16_t totalFormulas() {
+	return formulasInUse;
+}
+
+int registerFormula(const Formula* formula) {
+
+	Formula* newFormula;
+	int powBits;
+	size_t period = strlen(formula -> signs);
+
+	if (formulasInUse >= MAX_FORMULAS) {
+		fprintf(stderr, "\nFormula Registry is Full!\n");
+		return -1;
+	}
+
+	if (findFormula(formula -> key) != -1) {
+		fprintf(stderr, "\nFormula '%s' Already Exists!\n", formula -> key);
+		return -1;
+	}
+
+	if (formula -> shift < 1 || formula -> shift > 62 ||
+	    formula -> power < 1 || formula -> power > 2 ||
+	    !formula -> totalTerms || formula -> totalTerms > MAX_TERMS ||
+	    !period || period > MAX_SIGNS ||
+	    strspn(formula -> signs, "+-") != period) {
+		fprintf(stderr, "\nInvalid Formula Description!\n");
+		return -1;
+	}
+
+	powBits = gcd(4, formula -> shift);
+
+	for (int i = 0; i < formula -> totalTerms; i++) {
+		const Term* term = formula -> terms + i;
+
+		if (term -> m < 1 || term -> j < 1 || !term -> coef) {
+			fprintf(stderr, "\nInvalid Term in Formula!\n");
+			return -1;
+		}
+
+		powBits = gcd(powBits, term -> l);
+	}
+
+	newFormula = registry + formulasInUse;
+	memcpy(newFormula, formula, sizeof(Formula));
+	newFormula -> powBits = powBits;
+
+	return formulasInUse++;
+}
+
+int parseFormula(const char* text, Formula* formula) {
+
+	char* buffer, *token, *savePtr;
+	char* end;
+	uint64_t base;
+	int ret = 0;
+
+	memset(formula, 0, sizeof(Formula));
+
+	buffer = strdup(text);
+	if (!buffer)
+		return 1;
+
+	// Key
+	token = strtok_r(buffer, " ", &savePtr);
+	if (!token || strlen(token) >= FORMULA_KEY_SIZE) {
+		free(buffer);
+		return 1;
+	}
+
+	strcpy(formula -> key, token);
+	snprintf(formula -> description, FORMULA_DESC_SIZE, "User Formula '%s'", token);
+
+	// Base (Power of Two)
+	token = strtok_r(NULL, " ", &savePtr);
+	base = (token) ? strtoull(token, &end, 10) : 0;
+
+	if (!token || *end != '\0' || base < 2 || (base & (base - 1))) {
+		free(buffer);
+		return 1;
+	}
+
+	formula -> shift = __builtin_ctzll(base);
+
+	// Sign Pattern
+	token = strtok_r(NULL, " ", &savePtr);
+	if (!token || strlen(token) > MAX_SIGNS) {
+		free(buffer);
+		return 1;
+	}
+
+	strcpy(formula -> signs, token);
+
+	// Power of Denominators
+	token = strtok_r(NULL, " ", &savePtr);
+	formula -> power = (token) ? strtol(token, &end, 10) : 0;
+
+	if (!token || *end != '\0') {
+		free(buffer);
+		return 1;
+	}
+
+	// Terms
+	while ((token = strtok_r(NULL, " ", &savePtr))) {
+		Term* term;
+
+		if (formula -> totalTerms >= MAX_TERMS) {
+			ret = 1;
+			break;
+		}
+
+		term = formula -> terms + formula -> totalTerms;
+
+		if (sscanf(token, "%d,%d,%d,%d", &term -> m, &term -> j,
+		           &term -> l, &term -> coef) != 4) {
+			ret = 1;
+			break;
+		}
+
+		formula -> totalTerms++;
+	}
+
+	free(buffer);
+
+	return (ret || !formula -> totalTerms);
+}
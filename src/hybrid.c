@@ -0,0 +1,345 @@
+/*-----------------------------------------------------------------*/
+/**
+  @file   hybrid.c
+  @author Flávio M.
+  @brief  Original and Bellard Formulas Run at Once, Cross-Checked.
+ */
+/*-----------------------------------------------------------------*/
+
+/*-----------------------------------------------------------------
+                              Includes
+  -----------------------------------------------------------------*/
+#include <math.h>
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "../include/bbp.h"
+#include "../include/error-handler.h"
+#include "../include/formula.h"
+#include "../include/hybrid.h"
+#include "../include/job.h"
+#include "../include/output.h"
+
+
+/*-----------------------------------------------------------------
+                          Structs and Enums
+-----------------------------------------------------------------*/
+
+typedef struct hybridRun HybridRun;
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief One Formula of a Hybrid Run, Driven by its Own Thread.
+*/
+/*-----------------------------------------------------------------*/
+typedef struct {
+	BBPJob job;               // Engine State (Threads Set by The Split)
+	HybridRun* run;
+	long double result;
+	double time;              // Seconds From Start of The Run
+	bool finished;            // Every Batch Ran, Result is Valid
+} HybridSide;
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief Both Sides of a Hybrid Run. Guarded by The Mutex.
+*/
+/*-----------------------------------------------------------------*/
+struct hybridRun {
+	HybridSide sides[2];
+	pthread_mutex_t mutex;
+	pthread_cond_t done;
+	int returned;             // Sides Whose Thread Returned
+	int first;                // Index of First Finished Side (-1 = None)
+	double start;
+};
+
+
+/*-----------------------------------------------------------------
+                          Global Variables
+-----------------------------------------------------------------*/
+static const Algorithm hybridAlgos[2] = {BBP_ORIGINAL, BELLARD};
+
+
+/*-----------------------------------------------------------------
+                   Internal Functions Signatures
+  -----------------------------------------------------------------*/
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Split Threads Between The Formulas in Proportion to The
+           Terms of Their Left Summations (Each Term Costs One Modular
+           Exponentiation of About The Same Size), Each Getting at
+           Least One.
+   @param  const HybridRun* Run With Both Jobs Initialized.
+   @param  uint16_t         Total Threads (At Least 2).
+   @param  uint16_t*        Threads of Each Side.
+*/
+/*-----------------------------------------------------------------*/
+void splitThreads(const HybridRun*, uint16_t, uint16_t*);
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Terms Evaluated by The Left Summation of a Job.
+   @param  const BBPJob* Job Initialized by initJob.
+   @return double        Terms.
+*/
+/*-----------------------------------------------------------------*/
+double leftTerms(const BBPJob*);
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Thread of a Side. Runs its Job and Reports to The Run.
+   @param  void*  HybridSide.
+   @return void*  Null Pointer.
+*/
+/*-----------------------------------------------------------------*/
+void* runSide(void*);
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Leading Hex Digits Two Results Agree On.
+   @param  long double First Result.
+   @param  long double Second Result.
+   @return int         Matching Digits (Up to HYBRID_DIGITS).
+*/
+/*-----------------------------------------------------------------*/
+int matchingDigits(long double, long double);
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Current Time in Seconds (Monotonic).
+   @return double Seconds.
+*/
+/*-----------------------------------------------------------------*/
+static inline double now();
+
+
+/*-----------------------------------------------------------------
+                      Functions Implementation
+  -----------------------------------------------------------------*/
+static inline double now() {
+
+	struct timespec time;
+
+	clock_gettime(CLOCK_MONOTONIC_RAW, &time);
+
+	return time.tv_sec + time.tv_nsec / 1e9;
+}
+
+double leftTerms(const BBPJob* job) {
+
+	double terms = 0.0;
+
+	for (int i = 0; i < job -> formula -> totalTerms; i++)
+		terms += job -> termBounds[i];
+
+	return terms;
+}
+
+void splitThreads(const HybridRun* run, uint16_t nthreads, uint16_t* threads) {
+
+	double cost[2] = {leftTerms(&run -> sides[0].job), leftTerms(&run -> sides[1].job)};
+	long share = (cost[0] + cost[1] > 0.0) ?
+	             lround(nthreads * cost[0] / (cost[0] + cost[1])) : nthreads / 2;
+
+	// Equal Finishing Times, Threads Proportional to Work
+	if (share < 1)
+		share = 1;
+
+	if (share > nthreads - 1)
+		share = nthreads - 1;
+
+	threads[0] = share;
+	threads[1] = nthreads - share;
+}
+
+void* runSide(void* arg) {
+
+	HybridSide* side = (HybridSide*) arg;
+	HybridRun* run = side -> run;
+	long double result = bbpAlgo(&side -> job, NULL);
+
+	pthread_mutex_lock(&run -> mutex);
+
+	side -> result = result;
+	side -> time = now() - run -> start;
+
+	// Every Batch Was Taken and Ran, Even if Stopped Meanwhile
+	side -> finished = side -> job.count >= side -> job.upperBound;
+
+	if (side -> finished && run -> first == -1)
+		run -> first = side - run -> sides;
+
+	run -> returned++;
+	pthread_cond_signal(&run -> done);
+	pthread_mutex_unlock(&run -> mutex);
+
+	return NULL;
+}
+
+int matchingDigits(long double a, long double b) {
+
+	uint8_t bytes[FRACTION_BYTES];
+	char digits[2][HYBRID_DIGITS + 1];
+	int matching = 0;
+
+	packFraction(a, bytes, (HYBRID_DIGITS + 1) / 2);
+	formatDigits(bytes, HYBRID_DIGITS * 4, DIGITS_HEX, digits[0], sizeof(digits[0]));
+	packFraction(b, bytes, (HYBRID_DIGITS + 1) / 2);
+	formatDigits(bytes, HYBRID_DIGITS * 4, DIGITS_HEX, digits[1], sizeof(digits[1]));
+
+	while (matching < HYBRID_DIGITS && digits[0][matching] == digits[1][matching])
+		matching++;
+
+	return matching;
+}
+
+int evalHybrid(const Config* configs, HybridMode mode, HybridResult* result) {
+
+	HybridRun run;
+	pthread_t leaders[2];
+	uint16_t nthreads = (configs -> nthreads) ? configs -> nthreads : 1;
+	WorkerSlot places[nthreads];
+
+	memset(&run, 0, sizeof(HybridRun));
+	run.first = -1;
+
+	for (int i = 0; i < 2; i++) {
+		Config side = *configs;
+
+		side.algo = hybridAlgos[i];
+		side.digits = HYBRID_DIGITS;
+		run.sides[i].run = &run;
+
+		if (initJob(&run.sides[i].job, &side)) {
+			invalidArgumentException("Offset Too Large For Formula!");
+			return 1;
+		}
+	}
+
+	// One List of CPUs For Both Formulas, Split Into Disjoint Slices
+	for (int i = 0; i < nthreads; i++)
+		places[i] = (WorkerSlot) {.sum = 0, .job = NULL, .cpu = -1, .weight = 1};
+
+	nthreads = placeWorkers(places, nthreads, configs -> pinning);
+
+	pthread_mutex_init(&run.mutex, NULL);
+	pthread_cond_init(&run.done, NULL);
+	run.start = now();
+
+	// A Single Thread Runs The Formulas One After The Other, Cheaper
+	// First, so The First Result Needs no Second Formula
+	if (nthreads < 2) {
+		int cheaper = leftTerms(&run.sides[1].job) < leftTerms(&run.sides[0].job);
+
+		for (int k = 0; k < 2; k++) {
+			int i = (k) ? !cheaper : cheaper;
+
+			result -> threads[i] = 0;
+
+			if (mode == HYBRID_FIRST && run.first != -1)
+				continue;
+
+			run.sides[i].job.activeThreads = result -> threads[i] = 1;
+			runSide(run.sides + i);
+		}
+	} else {
+		splitThreads(&run, nthreads, result -> threads);
+
+		for (int i = 0; i < 2; i++) {
+			run.sides[i].job.activeThreads = result -> threads[i];
+			run.sides[i].job.places = places + ((i) ? result -> threads[0] : 0);
+
+			if (pthread_create(leaders + i, NULL, &runSide, run.sides + i) != 0) {
+				unexpectedError("Error Creating Threads!");
+			}
+		}
+
+		pthread_mutex_lock(&run.mutex);
+
+		while (run.returned < 2 && (mode == HYBRID_VERIFY || run.first == -1))
+			pthread_cond_wait(&run.done, &run.mutex);
+
+		pthread_mutex_unlock(&run.mutex);
+
+		// Slower Side Ends After The Batches it is Running
+		if (mode == HYBRID_FIRST)
+			for (int i = 0; i < 2; i++)
+				atomic_store(&run.sides[i].job.stop, true);
+
+		for (int i = 0; i < 2; i++) {
+			if (pthread_join(leaders[i], NULL) != 0) {
+				unexpectedError("Error Joining Threads!");
+			}
+		}
+	}
+
+	pthread_cond_destroy(&run.done);
+	pthread_mutex_destroy(&run.mutex);
+
+	for (int i = 0; i < 2; i++) {
+		const HybridSide* side = run.sides + i;
+
+		result -> values[i] = (side -> finished) ? side -> result : NAN;
+		result -> times[i] = (side -> finished) ? side -> time : -1.0;
+	}
+
+	result -> first = hybridAlgos[run.first];
+	result -> result = run.sides[run.first].result;
+	result -> matching = -1;
+
+	if (run.sides[0].finished && run.sides[1].finished)
+		result -> matching = matchingDigits(run.sides[0].result, run.sides[1].result);
+
+	return 0;
+}
+
+int calcHybrid(Config* currConfigs, HybridMode mode) {
+
+	HybridResult result;
+	uint8_t bytes[FRACTION_BYTES];
+	char digits[HYBRID_DIGITS + 1];
+	double start = now();
+
+	if (evalHybrid(currConfigs, mode, &result))
+		return 1;
+
+	printf("\nHybrid @ %lu (%s %d Threads, %s %d Threads):\n", currConfigs -> startPos,
+	       getFormula(hybridAlgos[0]) -> key, result.threads[0],
+	       getFormula(hybridAlgos[1]) -> key, result.threads[1]);
+
+	for (int i = 0; i < 2; i++) {
+		const char* key = getFormula(hybridAlgos[i]) -> key;
+
+		if (result.times[i] < 0.0) {
+			printf("%-9s Stopped\n", key);
+			continue;
+		}
+
+		packFraction(result.values[i], bytes, (HYBRID_DIGITS + 1) / 2);
+		formatDigits(bytes, HYBRID_DIGITS * 4, DIGITS_HEX, digits, sizeof(digits));
+		printf("%-9s %s (%.5fs%s)\n", key, digits, result.times[i],
+		       (hybridAlgos[i] == result.first) ? ", First" : "");
+	}
+
+	if (result.matching < 0)
+		printf("Unverified: Only %s Finished\n", getFormula(result.first) -> key);
+	else if (result.matching == HYBRID_DIGITS)
+		printf("Verified: %d/%d Digits Agree\n", result.matching, HYBRID_DIGITS);
+	else
+		printf("[MISMATCH] Only %d/%d Leading Digits Agree\n", result.matching, HYBRID_DIGITS);
+
+	printf("Total Exec. Time: %.5fs\n", now() - start);
+
+	return result.matching >= 0 && result.matching < HYBRID_DIGITS;
+}
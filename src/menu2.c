@@ -435,12 +435,13 @@ void setEntry(MenuSt* menu, PageNode page) {
 	}
 
 	memcpy(table + index, &page, sizeof(PageNode));
+	menu -> currElements++;
 }
 
 
 int expandTable(MenuSt* menu) {
 
-	size_t newSize = menu->tableSize * 2;
+	size_t oldSize = menu->tableSize, newSize = oldSize * 2;
 	PageNode* newTable, *oldTable;
 
     // Check If New Table Size is Within Bounds
@@ -455,9 +456,10 @@ int expandTable(MenuSt* menu) {
 	oldTable = menu->table;
 	menu -> table = newTable;
 	menu -> tableSize = newSize;
+	menu -> currElements = 0;
 
     // Reallocates All Nodes
-	for (uint16_t i = 0; i < newSize; i++) {
+	for (uint16_t i = 0; i < oldSize; i++) {
 		PageNode page = oldTable[i];
 
 		if (page.hash)
@@ -0,0 +1,260 @@
+/*-----------------------------------------------------------------*/
+/**
+  @file   modular.c
+  @author Flávio M.
+  @brief  Montgomery Arithmetic For Moduli Beyond The Barrett Path.
+ */
+/*-----------------------------------------------------------------*/
+
+/*-----------------------------------------------------------------
+                              Includes
+  -----------------------------------------------------------------*/
+#include <stdint.h>
+#include "../include/modular.h"
+
+
+/*-----------------------------------------------------------------
+                   Internal Functions Signatures
+  -----------------------------------------------------------------*/
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Montgomery Multiplication, a * b / 2^64 mod n.
+   @param  uint64_t a (< n).
+   @param  uint64_t b (< n).
+   @param  uint64_t Odd Modulus (n < 2^63).
+   @param  uint64_t -n^-1 mod 2^64.
+   @return uint64_t a * b * 2^-64 mod n.
+*/
+/*-----------------------------------------------------------------*/
+static inline uint64_t montMul64(uint64_t, uint64_t, uint64_t, uint64_t);
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Montgomery Multiplication, a * b / 2^128 mod n.
+   @param  __uint128_t a (< n).
+   @param  __uint128_t b (< n).
+   @param  __uint128_t Odd Modulus (n < 2^126).
+   @param  __uint128_t -n^-1 mod 2^128.
+   @return __uint128_t a * b * 2^-128 mod n.
+*/
+/*-----------------------------------------------------------------*/
+static inline __uint128_t montMul128(__uint128_t, __uint128_t, __uint128_t, __uint128_t);
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Full 256-Bit Product of Two 128-Bit Numbers.
+   @param  __uint128_t  a.
+   @param  __uint128_t  b.
+   @param  __uint128_t* High 128 Bits of Product.
+   @return __uint128_t  Low 128 Bits of Product.
+*/
+/*-----------------------------------------------------------------*/
+static inline __uint128_t mul256(__uint128_t, __uint128_t, __uint128_t*);
+
+
+/*-----------------------------------------------------------------
+                      Functions Implementation
+  -----------------------------------------------------------------*/
+static inline uint64_t montMul64(uint64_t a, uint64_t b,
+                                 uint64_t n, uint64_t nInv) {
+
+	__uint128_t t = (__uint128_t) a * b;
+	uint64_t m = (uint64_t) t * nInv;
+	uint64_t u = (t + (__uint128_t) m * n) >> 64;
+
+	return (u >= n) ? u - n : u;
+}
+
+static inline __uint128_t mul256(__uint128_t a, __uint128_t b, __uint128_t* hi) {
+
+	uint64_t a0 = a, a1 = a >> 64, b0 = b, b1 = b >> 64;
+	__uint128_t p00 = (__uint128_t) a0 * b0, p01 = (__uint128_t) a0 * b1;
+	__uint128_t p10 = (__uint128_t) a1 * b0, p11 = (__uint128_t) a1 * b1;
+	__uint128_t mid = (p00 >> 64) + (uint64_t) p01 + (uint64_t) p10;
+
+	*hi = p11 + (p01 >> 64) + (p10 >> 64) + (mid >> 64);
+
+	return (mid << 64) | (uint64_t) p00;
+}
+
+static inline __uint128_t montMul128(__uint128_t a, __uint128_t b,
+                                     __uint128_t n, __uint128_t nInv) {
+
+	__uint128_t tHi, mHi, u;
+	__uint128_t tLo = mul256(a, b, &tHi);
+	__uint128_t m = tLo * nInv;
+
+	mul256(m, n, &mHi);
+
+	// Low Halves Add Up to 0 mod 2^128, Only Their Carry is Left
+	u = tHi + mHi + (tLo != 0);
+
+	return (u >= n) ? u - n : u;
+}
+
+uint64_t barrettFactor(uint64_t base, long double inverse) {
+
+	// Double Precision is Enough, and Converts Without x87 Control Words
+	double approx = inverse;
+	uint64_t factor, rem;
+
+	if (base == 1)
+		return UINT64_MAX;
+
+	// Off by Up to 2^15 / base + 2 Units, Halved to Fit a Signed Word
+	factor = 2 * (uint64_t) (int64_t) (approx * 0x1p63);
+
+	if (base >> 61) {
+		while ((__uint128_t) factor * base > UINT64_MAX)
+			factor--;
+
+		while (((__uint128_t) factor + 1) * base <= UINT64_MAX)
+			factor++;
+
+		return factor;
+	}
+
+	// Small Signed Remainder, its Quotient Leaves The Factor Off by One
+	rem = UINT64_MAX - factor * base;
+	factor += (int64_t) ((int64_t) rem * approx);
+
+	// Branch Free Last Step
+	rem = UINT64_MAX - factor * base;
+	factor -= (int64_t) rem < 0;
+	factor += (int64_t) rem >= (int64_t) base;
+
+	return factor;
+}
+
+void batchInverse(const long double* x, long double* inverse, int size) {
+
+	long double acc;
+
+	// inverse[i] = x[0] * ... * x[i]
+	inverse[0] = x[0];
+
+	for (int i = 1; i < size; i++)
+		inverse[i] = inverse[i - 1] * x[i];
+
+	acc = 1.0L / inverse[size - 1];
+
+	// acc = 1 / (x[0] * ... * x[i]) on Each Step
+	for (int i = size - 1; i > 0; i--) {
+		inverse[i] = acc * inverse[i - 1];
+		acc *= x[i];
+	}
+
+	inverse[0] = acc;
+}
+
+uint64_t modPow2Mont(uint64_t exp, uint64_t base) {
+	return modPow2MontInv(exp, base, 1.0L / base);
+}
+
+uint64_t modPow2MontInv(uint64_t exp, uint64_t base, long double inverse) {
+
+	int t = __builtin_ctzll(base), bit;
+	uint64_t odd = base >> t, nInv = odd, x;
+
+	// 2^exp mod (2^t * odd) = 2^t * (2^(exp - t) mod odd)
+	if (exp < (uint64_t) t)
+		return 1ULL << exp;
+
+	exp -= t;
+
+	if (odd == 1)
+		return 0;
+
+	// Newton Iterations Double Correct Bits: 3, 6, ..., 96
+	for (int i = 0; i < 5; i++)
+		nInv *= 2 - odd * nInv;
+
+	nInv = -nInv;
+
+	// 1 in Montgomery Form, 2^64 mod odd = (2^64 - 1) mod odd + 1
+	x = UINT64_MAX - barrettFactor(odd, inverse * (1ULL << t)) * odd + 1;
+
+	if (x == odd)
+		x = 0;
+
+	// Left to Right, Squares Are Multiplications, Bits Are Doublings
+	for (bit = 63 - __builtin_clzll(exp | 1); bit >= 0; bit--) {
+		x = montMul64(x, x, odd, nInv);
+
+		if ((exp >> bit) & 1) {
+			x <<= 1;
+
+			if (x >= odd)
+				x -= odd;
+		}
+	}
+
+	return montMul64(x, 1, odd, nInv) << t;
+}
+
+__uint128_t modPow2Wide(__uint128_t exp, __uint128_t base) {
+
+	uint64_t low = base;
+	int t = (low) ? __builtin_ctzll(low) : 64 + __builtin_ctzll(base >> 64);
+	int bit;
+	__uint128_t odd = base >> t, nInv = odd, x;
+
+	if (exp < (__uint128_t) t)
+		return (__uint128_t) 1 << exp;
+
+	exp -= t;
+
+	if (odd == 1)
+		return 0;
+
+	for (int i = 0; i < 6; i++)
+		nInv *= 2 - odd * nInv;
+
+	nInv = -nInv;
+	x = (0 - odd) % odd;
+
+	bit = (exp >> 64) ? 127 - __builtin_clzll(exp >> 64)
+	                  : 63 - __builtin_clzll((uint64_t) exp | 1);
+
+	for (; bit >= 0; bit--) {
+		x = montMul128(x, x, odd, nInv);
+
+		if ((exp >> bit) & 1) {
+			x <<= 1;
+
+			if (x >= odd)
+				x -= odd;
+		}
+	}
+
+	return montMul128(x, 1, odd, nInv) << t;
+}
+
+__uint128_t mulModSlow(__uint128_t a, __uint128_t b, __uint128_t base) {
+
+	__uint128_t result = 0;
+
+	a %= base;
+
+	while (b) {
+
+		if (b & 1) {
+			result += a;
+
+			if (result >= base)
+				result -= base;
+		}
+
+		a <<= 1;
+
+		if (a >= base)
+			a -= base;
+
+		b >>= 1;
+	}
+
+	return result;
+}
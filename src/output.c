@@ -0,0 +1,160 @@
+/*-----------------------------------------------------------------*/
+/**
+  @file   output.c
+  @author Flávio M.
+  @brief  Formatting of Extracted Digits (Hex, Binary, Octal, Raw).
+ */
+/*-----------------------------------------------------------------*/
+
+/*-----------------------------------------------------------------
+                              Includes
+  -----------------------------------------------------------------*/
+#include <math.h>
+#include <stdint.h>
+#include <string.h>
+#include "../include/output.h"
+
+
+/*-----------------------------------------------------------------
+                   Internal Functions Signatures
+  -----------------------------------------------------------------*/
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Read Up to 8 Bits From Packed Bytes.
+   @param  const uint8_t* Packed Bytes, Most Significant First.
+   @param  size_t         Position of First Bit.
+   @param  int            Number of Bits (1-8).
+   @return unsigned       Bits Read.
+*/
+/*-----------------------------------------------------------------*/
+static inline unsigned readBits(const uint8_t*, size_t, int);
+
+
+/*-----------------------------------------------------------------
+                      Functions Implementation
+  -----------------------------------------------------------------*/
+static inline unsigned readBits(const uint8_t* bytes, size_t pos, int bits) {
+
+	unsigned window = bytes[pos / 8] << 8;
+
+	// Only Touch Next Byte When The Bits Cross It
+	if ((pos % 8) + bits > 8)
+		window |= bytes[pos / 8 + 1];
+
+	return (window >> (16 - (pos % 8) - bits)) & ((1u << bits) - 1);
+}
+
+size_t packFraction(long double x, uint8_t* bytes, size_t totalBytes) {
+
+	long double frac = x - floorl(x);
+	uint64_t bits;
+
+	if (totalBytes > FRACTION_BYTES)
+		totalBytes = FRACTION_BYTES;
+
+	// Values Like -1e-30 Round Up to 1.0
+	bits = (frac >= 1.0L) ? UINT64_MAX : (uint64_t) ldexpl(frac, 64);
+
+	for (size_t i = 0; i < totalBytes; i++)
+		bytes[i] = bits >> (56 - 8 * i);
+
+	return totalBytes;
+}
+
+int guaranteedDigits(long double x, long double bound, int maxDigits) {
+
+	long double frac = x - floorl(x);
+	long double low = frac - bound, high = frac + bound;
+	int digits = 0;
+
+	// Interval Crosses 0, Not Even The First Digit is Known
+	if (low < 0.0L || high >= 1.0L)
+		return 0;
+
+	// Scaling by 16 and Dropping Integer Parts is Exact
+	while (digits < maxDigits) {
+		low *= 16;
+		high *= 16;
+
+		if (floorl(low) != floorl(high))
+			break;
+
+		low -= floorl(low);
+		high -= floorl(high);
+		digits++;
+	}
+
+	return digits;
+}
+
+size_t formattedSize(size_t bits, DigitFormat format) {
+
+	switch (format) {
+
+        case DIGITS_HEX:
+			return bits / 4 + 1;
+
+        case DIGITS_BIN:
+			return bits + 1;
+
+        case DIGITS_OCT:
+			return bits / 3 + 1;
+
+        case DIGITS_RAW:
+			return (bits + 7) / 8;
+	}
+
+	return 0;
+}
+
+size_t formatDigits(const uint8_t* bytes, size_t bits, DigitFormat format,
+                    char* out, size_t outSize) {
+
+	static const char digits[] = "0123456789ABCDEF";
+	size_t written = 0;
+
+	if (formattedSize(bits, format) > outSize)
+		return 0;
+
+	switch (format) {
+
+        case DIGITS_HEX:
+			for (size_t i = 0; i + 4 <= bits; i += 4)
+				out[written++] = digits[readBits(bytes, i, 4)];
+			break;
+
+        case DIGITS_BIN:
+			for (size_t i = 0; i < bits; i++)
+				out[written++] = digits[readBits(bytes, i, 1)];
+			break;
+
+        case DIGITS_OCT:
+			for (size_t i = 0; i + 3 <= bits; i += 3)
+				out[written++] = digits[readBits(bytes, i, 3)];
+			break;
+
+        case DIGITS_RAW:
+			written = (bits + 7) / 8;
+			memcpy(out, bytes, written);
+			return written;
+	}
+
+	out[written] = '\0';
+
+	return written;
+}
+
+int parseDigitFormat(const char* name, DigitFormat* format) {
+
+	static const char* names[] = {"hex", "bin", "oct", "raw"};
+
+	for (int i = 0; i < 4; i++) {
+		if (!strcmp(name, names[i])) {
+			*format = (DigitFormat) i;
+			return 0;
+		}
+	}
+
+	return 1;
+}
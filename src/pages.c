@@ -12,11 +12,16 @@
 #include <stdbool.h>
 #include <stdio.h>
 #include <stdint.h>
+#include <stdlib.h>
 #include <string.h>
 #include "../include/error-handler.h"
+#include "../include/background.h"
 #include "../include/bbp.h"
+#include "../include/formula.h"
 #include "../include/menu2.h"
 #include "../include/pages.h"
+#include "../include/topology.h"
+#include "../include/tune.h"
 
 #ifdef _WIN32
 
@@ -32,13 +37,26 @@
 /*-----------------------------------------------------------------
                             Definitions
    -----------------------------------------------------------------*/
-#define TOTAL_PAGES 7
+#define TOTAL_PAGES 27
+#define MAX_QUEUED 16   // Offsets Queued at Once
 
 static char *pagesText[TOTAL_PAGES] = {
-    "\n====== Pi-BBP ======\n\n[1] Algorithm: %s\n[2] Threads: %d\n[3] Offset: %s\n\n[4] Start Computation!\n\n[0] Exit\n",
-    "\nCurrent Algorithm: %s\n\n[1] BBP-Original (4-Term)\n[2] Bellard (7-Term)\n\n[0] Return\n",
+    "\n====== Pi-BBP ======\n\n[1] Algorithm: %s\n[2] Threads: %d\n[3] Offset: %s\n\n[4] Start Computation!\n[5] Background Jobs (%d Running)\n[6] Tuning\n\n[0] Exit\n",
+    "\nCurrent Algorithm: %s\n\n%s\nFormula (0 = Keep Current):\n",
     "\nCurrent Threads: %d\nMax Threads: %d\nOptimal for Current Offset: %s\n",
-    "\nCurrent Offset: %s\n", "algo_action1", "algo_action2", "compute_bbp_action1"};
+    "\nCurrent Offset: %s\n", "compute_bbp_action1",
+    "\n====== Background Jobs ======\n\n%s\n[1] Queue Current Settings\n[2] Queue Several Offsets\n[3] Watch Progress\n[4] Cancel a Job\n[5] History\n\n[0] Return\n",
+    "\nOffsets to Queue, Separated by Spaces (%s, %d Threads):\n",
+    "\n%s\nJob to Cancel (Id):\n", "queue_job_action1", "watch_jobs_action1", "history_action1",
+    "\n====== Tuning ======\n\n[1] Batch Size: %s\n[2] Digits: %d\n[3] Kernel: %s\n[4] Pinning: %s\n[5] Scheduler: %s\n\n[6] Quick Benchmark\n\n[0] Return\n",
+    "\nCurrent Batch Size: %s\nElements Each Thread Takes at Once (0 = Default, %d):\n",
+    "\nCurrent Digits: %d\nHex Digits Wanted (1-%d, 0 = Default):\n",
+    "\nCurrent Kernel: %s\n\n[1] Auto (128-Bit Only When Needed)\n[2] Generic (Formula Read at Run Time)\n[3] Wide (128-Bit at Every Offset)\n\n[0] Return\n",
+    "\nCurrent Pinning: %s\n\n[1] None (Placed by The OS)\n[2] One Thread Per Physical Core\n[3] One Thread Per Logical CPU\n\n[0] Return\n",
+    "\nCurrent Scheduler: %s\n\n[1] Weighted (Faster Cores Take More Batches)\n[2] Equal (One Batch at a Time)\n[3] Static (Interleaved, No Shared Counter)\n\n[0] Return\n",
+    "quick_benchmark_action1", "kernel_action1", "kernel_action2", "kernel_action3",
+    "pinning_action1", "pinning_action2", "pinning_action3",
+    "scheduler_action1", "scheduler_action2", "scheduler_action3"};
 
 
 /*-----------------------------------------------------------------
@@ -129,7 +147,6 @@ char* mainPage(char*, void*);
 
 char* algoPageText(char*, void*);
 int algoPageAction1(char*, void*);
-int algoPageAction2(char*, void*);
 
 char* threadsPageText(char*, void*);
 int threadsPageAction1(char*, void*);
@@ -140,6 +157,41 @@ int offsetPageAction1(char*, void*);
 
 int computeBBP(char *, void *);
 
+char* jobsPageText(char*, void*);
+int queueJobAction(char*, void*);
+int watchJobsAction(char*, void*);
+int historyAction(char*, void*);
+
+char* queueOffsetsText(char*, void*);
+int queueOffsetsAction(char*, void*);
+
+char* cancelJobText(char*, void*);
+int cancelJobAction(char*, void*);
+
+char* tuningPageText(char*, void*);
+int quickBenchmarkAction(char*, void*);
+
+char* batchPageText(char*, void*);
+int batchPageAction1(char*, void*);
+
+char* digitsPageText(char*, void*);
+int digitsPageAction1(char*, void*);
+
+char* kernelPageText(char*, void*);
+int kernelPageAction1(char*, void*);
+int kernelPageAction2(char*, void*);
+int kernelPageAction3(char*, void*);
+
+char* pinningPageText(char*, void*);
+int pinningPageAction1(char*, void*);
+int pinningPageAction2(char*, void*);
+int pinningPageAction3(char*, void*);
+
+char* schedulerPageText(char*, void*);
+int schedulerPageAction1(char*, void*);
+int schedulerPageAction2(char*, void*);
+int schedulerPageAction3(char*, void*);
+
 
 /*-----------------------------------------------------------------
                       Functions Implementation
@@ -154,22 +206,18 @@ MenuSt* initPages() {
 		hash[i] = hashKey(pagesText[i]);
 
 	// Root Page
-	uint32_t *forwardHashes1 =(uint32_t*) malloc(sizeof(uint32_t) * 4);
+	uint32_t *forwardHashes1 =(uint32_t*) malloc(sizeof(uint32_t) * 6);
 	checkNullPointer((void *) forwardHashes1);
 	forwardHashes1[0] = hash[1];
 	forwardHashes1[1] = hash[2];
 	forwardHashes1[2] = hash[3];
-	forwardHashes1[3] = hash[6];	
-	addPage(menu, pagesText[0], 1, &mainPage, NULL, forwardHashes1, 4, hash[0], TEXT);
+	forwardHashes1[3] = hash[4];	
+	forwardHashes1[4] = hash[5];
+	forwardHashes1[5] = hash[11];
+	addPage(menu, pagesText[0], 1, &mainPage, NULL, forwardHashes1, 6, hash[0], TEXT);
 
-	// Algorithm Selection Page
-	uint32_t *forwardHashes2 = (uint32_t*) malloc(sizeof(uint32_t) * 2);
-	checkNullPointer((void *) forwardHashes1);
-	forwardHashes2[0] = hash[4];
-    forwardHashes2[1] = hash[5];
-	addPage(menu, pagesText[1], 1, &algoPageText, NULL, forwardHashes2, 2, hash[0], TEXT);
-	addPage(menu, pagesText[4], 1, NULL, &algoPageAction1, NULL, 0, hash[0], ACTION);
-	addPage(menu, pagesText[5], 1, NULL, &algoPageAction2, NULL, 0, hash[0], ACTION);
+	// Algorithm Selection, Every Formula in The Registry
+	addPage(menu, pagesText[1], 1, &algoPageText, &algoPageAction1, NULL, 0, hash[0], INPUT);
 
 	// Number of Threads Selection
 	addPage(menu, pagesText[2], 1, &threadsPageText, &threadsPageAction1, NULL, 0, hash[0], INPUT);
@@ -178,9 +226,57 @@ MenuSt* initPages() {
 	addPage(menu, pagesText[3], 1, &offsetPageText, &offsetPageAction1, NULL, 0, hash[0], INPUT);
 
 	// Compute BBP
-	addPage(menu, pagesText[6], 1, NULL, &computeBBP, NULL, 0, hash[0],
+	addPage(menu, pagesText[4], 1, NULL, &computeBBP, NULL, 0, hash[0],
                 ACTION);
 
+	// Background Jobs
+	uint32_t *forwardHashes3 = (uint32_t*) malloc(sizeof(uint32_t) * 5);
+	checkNullPointer((void *) forwardHashes3);
+	forwardHashes3[0] = hash[8];
+	forwardHashes3[1] = hash[6];
+	forwardHashes3[2] = hash[9];
+	forwardHashes3[3] = hash[7];
+	forwardHashes3[4] = hash[10];
+	addPage(menu, pagesText[5], 1, &jobsPageText, NULL, forwardHashes3, 5, hash[0], TEXT);
+	addPage(menu, pagesText[6], 1, &queueOffsetsText, &queueOffsetsAction, NULL, 0, hash[5], INPUT);
+	addPage(menu, pagesText[7], 1, &cancelJobText, &cancelJobAction, NULL, 0, hash[5], INPUT);
+	addPage(menu, pagesText[8], 1, NULL, &queueJobAction, NULL, 0, hash[5], ACTION);
+	addPage(menu, pagesText[9], 1, NULL, &watchJobsAction, NULL, 0, hash[5], ACTION);
+	addPage(menu, pagesText[10], 1, NULL, &historyAction, NULL, 0, hash[5], ACTION);
+
+	// Tuning
+	uint32_t *forwardHashes4 = (uint32_t*) malloc(sizeof(uint32_t) * 6);
+	checkNullPointer((void *) forwardHashes4);
+
+	for (int i = 0; i < 6; i++)
+		forwardHashes4[i] = hash[12 + i];
+
+	addPage(menu, pagesText[11], 1, &tuningPageText, NULL, forwardHashes4, 6, hash[0], TEXT);
+	addPage(menu, pagesText[12], 1, &batchPageText, &batchPageAction1, NULL, 0, hash[11], INPUT);
+	addPage(menu, pagesText[13], 1, &digitsPageText, &digitsPageAction1, NULL, 0, hash[11], INPUT);
+	addPage(menu, pagesText[17], 1, NULL, &quickBenchmarkAction, NULL, 0, hash[11], ACTION);
+
+	// Kernel, Pinning and Scheduler Choices, Three Each
+	char* (*choiceTexts[3]) (char*, void*) = {&kernelPageText, &pinningPageText, &schedulerPageText};
+	int (*choiceActions[9]) (char*, void*) = {
+		&kernelPageAction1, &kernelPageAction2, &kernelPageAction3,
+		&pinningPageAction1, &pinningPageAction2, &pinningPageAction3,
+		&schedulerPageAction1, &schedulerPageAction2, &schedulerPageAction3};
+
+	for (int page = 0; page < 3; page++) {
+		uint32_t *forwardHashes = (uint32_t*) malloc(sizeof(uint32_t) * 3);
+		checkNullPointer((void *) forwardHashes);
+
+		for (int i = 0; i < 3; i++) {
+			forwardHashes[i] = hash[18 + 3 * page + i];
+			addPage(menu, pagesText[18 + 3 * page + i], 1, NULL, choiceActions[3 * page + i],
+			        NULL, 0, hash[11], ACTION);
+		}
+
+		addPage(menu, pagesText[14 + page], 1, choiceTexts[page], NULL, forwardHashes, 3,
+		        hash[11], TEXT);
+	}
+
     menu -> rootHash = hash[0];
             
 	return menu;
@@ -194,22 +290,24 @@ Config* initDefaultConfigs() {
 	defaultConfigs -> startPos = 10000;
 	defaultConfigs -> nthreads = 12;
 	defaultConfigs -> algo = BELLARD;
+	defaultConfigs -> report = REPORT_TEXT;
+	defaultConfigs -> digits = 0;
+	defaultConfigs -> pinning = PIN_NONE;
+	defaultConfigs -> batchSize = 0;
+	defaultConfigs -> kernel = KERNEL_AUTO;
+	defaultConfigs -> scheduler = SCHED_WEIGHTED;
         
 	return defaultConfigs;
 }
 
 char* getAlgoString(Algorithm algo) {
 
-	switch (algo) {
-
-        case BBP_ORIGINAL:
-			return "Original (4-Terms)";
+	const Formula* formula = getFormula(algo);
 
-	    case BELLARD:
-			return "Bellard (7-Term)";
-	}
+	if (!formula)
+		return NULL;
 
-    return NULL;
+    return (char*) formula -> description;
 }
 
 char* format64UInteger(uint64_t num) {
@@ -263,7 +361,7 @@ uint16_t getMaxThreads() {
 
 	return maxThreads;	
 #else
-	return sysconf(_SC_NPROCESSORS_CONF);
+	return getTopology() -> total;
 #endif  
 }
 
@@ -339,7 +437,8 @@ char* mainPage(char* text, void* configSt) {
 			 text,
 			 algoString,
 			 configs->nthreads,
-			 formatedOffset);
+			 formatedOffset,
+			 runningComputations());
 
 	free(formatedOffset);
         
@@ -351,6 +450,8 @@ char* algoPageText(char* text, void* configSt) {
 	char* buffer;
 	Config* configs = (Config*) configSt;
 	char* algoString = getAlgoString(configs->algo);
+	char list[BUFFER_SIZE];
+	int length = 0;
 
 	buffer = (char *)malloc(sizeof(char) * BUFFER_SIZE);
 	checkNullPointer((void*) buffer);
@@ -359,11 +460,19 @@ char* algoPageText(char* text, void* configSt) {
 	if (!algoString)
 		return NULL;
 
+	// One Option Per Registered Formula, Built-In Ones First
+	list[0] = '\0';
+
+	for (int i = 0; i < totalFormulas() && length < BUFFER_SIZE; i++)
+		length += snprintf(list + length, BUFFER_SIZE - length, "[%d] %s\n", i + 1,
+		                   getFormula(i) -> description);
+
 	// Print Page Text
 	snprintf(buffer,
 			 BUFFER_SIZE,
 			 text,
-			 algoString);
+			 algoString,
+			 list);
 
 	return buffer;
 }
@@ -372,15 +481,13 @@ char* algoPageText(char* text, void* configSt) {
 int algoPageAction1(char* input, void* configSt) {
 
 	Config *configs = (Config *)configSt;
-	configs->algo = BBP_ORIGINAL;
-		
-	return 0;	
-}
+	uint16_t option;
 
-int algoPageAction2(char* input, void* configSt) {
+	if (getU16IntFromInput(input, &option) || option > totalFormulas())
+		return 1;
 
-	Config *configs = (Config *)configSt;
-	configs->algo = BELLARD;
+	if (option)
+		configs->algo = option - 1;
 		
 	return 0;	
 }
@@ -460,6 +567,295 @@ int offsetPageAction1(char* input, void* configSt) {
 
 int computeBBP(char* input, void* configSt) {
 
-	calcBBP((Config*) configSt);
+	// Runs in Background, Watching Can Stop at Any Time
+	if (queueComputation((Config*) configSt) < 0)
+		return 0;
+
+	watchComputations();
+
+	return 0;
+}
+
+char* jobsPageText(char* text, void* configSt) {
+
+	char* buffer = (char *)malloc(sizeof(char) * BUFFER_SIZE);
+	char list[BUFFER_SIZE / 2];
+
+	checkNullPointer((void*) buffer);
+
+	if (!listComputations(list, sizeof(list)))
+		strcpy(list, "No Jobs Running.\n");
+
+	snprintf(buffer, BUFFER_SIZE, text, list);
+
+	return buffer;
+}
+
+int queueJobAction(char* input, void* configSt) {
+
+	int id = queueComputation((Config*) configSt);
+
+	if (id >= 0)
+		printf("\nQueued Job #%d\n", id);
+
+	return 0;
+}
+
+int watchJobsAction(char* input, void* configSt) {
+
+	watchComputations();
+	return 0;
+}
+
+int historyAction(char* input, void* configSt) {
+
+	printHistory();
+	return 0;
+}
+
+char* queueOffsetsText(char* text, void* configSt) {
+
+	Config *configs = (Config *)configSt;
+	char* buffer = (char *)malloc(sizeof(char) * BUFFER_SIZE);
+
+	checkNullPointer((void*) buffer);
+	snprintf(buffer, BUFFER_SIZE, text, getFormula(configs -> algo) -> key, configs -> nthreads);
+
+	return buffer;
+}
+
+int queueOffsetsAction(char* input, void* configSt) {
+
+	Config job = *(Config *)configSt;
+	char* cursor = input;
+	char* end;
+	int queued = 0;
+
+	while (queued < MAX_QUEUED) {
+		uint64_t offset = strtoull(cursor, &end, 10);
+
+		if (end == cursor)
+			break;
+
+		job.startPos = offset;
+
+		if (queueComputation(&job) < 0)
+			break;
+
+		queued++;
+		cursor = end;
+	}
+
+	// Anything Left Must be Blank
+	while (*cursor == ' ' || *cursor == '\t')
+		cursor++;
+
+	if (queued)
+		printf("\nQueued %d Jobs\n", queued);
+
+	return !queued || (*cursor != '\n' && *cursor != '\0');
+}
+
+char* cancelJobText(char* text, void* configSt) {
+
+	char* buffer = (char *)malloc(sizeof(char) * BUFFER_SIZE);
+	char list[BUFFER_SIZE / 2];
+
+	checkNullPointer((void*) buffer);
+
+	if (!listComputations(list, sizeof(list)))
+		strcpy(list, "No Jobs Running.\n");
+
+	snprintf(buffer, BUFFER_SIZE, text, list);
+
+	return buffer;
+}
+
+int cancelJobAction(char* input, void* configSt) {
+
+	uint16_t id;
+
+	if (getU16IntFromInput(input, &id))
+		return 1;
+
+	return cancelComputation(id);
+}
+
+char* tuningPageText(char* text, void* configSt) {
+
+	Config *configs = (Config *)configSt;
+	char* buffer = (char *)malloc(sizeof(char) * BUFFER_SIZE);
+	char* formatedBatch;
+
+	checkNullPointer((void*) buffer);
+
+	formatedBatch = format64UInteger((configs -> batchSize) ? configs -> batchSize : BATCH_SIZE);
+
+	snprintf(buffer, BUFFER_SIZE, text, formatedBatch,
+	         (configs -> digits) ? configs -> digits : PRECISION,
+	         kernelName(configs -> kernel), pinningName(configs -> pinning),
+	         schedulerName(configs -> scheduler));
+
+	free(formatedBatch);
+
+	return buffer;
+}
+
+int quickBenchmarkAction(char* input, void* configSt) {
+
+	// Timings Are Only Meaningful on an Idle Machine
+	if (runningComputations()) {
+		fprintf(stderr, "\nWait For Background Jobs to Finish First!\n");
+		return 0;
+	}
+
+	quickBenchmark((Config*) configSt);
+
+	return 0;
+}
+
+char* batchPageText(char* text, void* configSt) {
+
+	Config *configs = (Config *)configSt;
+	char* buffer = (char *)malloc(sizeof(char) * BUFFER_SIZE);
+	char* formatedBatch;
+
+	checkNullPointer((void*) buffer);
+
+	formatedBatch = format64UInteger((configs -> batchSize) ? configs -> batchSize : BATCH_SIZE);
+	snprintf(buffer, BUFFER_SIZE, text, formatedBatch, BATCH_SIZE);
+	free(formatedBatch);
+
+	return buffer;
+}
+
+int batchPageAction1(char* input, void* configSt) {
+
+	Config *configs = (Config *)configSt;
+	uint64_t batchSize;
+
+	if (getU64IntFromInput(input, &batchSize))
+		return 1;
+
+	configs -> batchSize = batchSize;
+
+	return 0;
+}
+
+char* digitsPageText(char* text, void* configSt) {
+
+	Config *configs = (Config *)configSt;
+	char* buffer = (char *)malloc(sizeof(char) * BUFFER_SIZE);
+
+	checkNullPointer((void*) buffer);
+	snprintf(buffer, BUFFER_SIZE, text, (configs -> digits) ? configs -> digits : PRECISION,
+	         MAX_DIGITS);
+
+	return buffer;
+}
+
+int digitsPageAction1(char* input, void* configSt) {
+
+	Config *configs = (Config *)configSt;
+	uint16_t digits;
+
+	if (getU16IntFromInput(input, &digits) || digits > MAX_DIGITS)
+		return 1;
+
+	configs -> digits = digits;
+
+	return 0;
+}
+
+char* kernelPageText(char* text, void* configSt) {
+
+	Config *configs = (Config *)configSt;
+	char* buffer = (char *)malloc(sizeof(char) * BUFFER_SIZE);
+
+	checkNullPointer((void*) buffer);
+	snprintf(buffer, BUFFER_SIZE, text, kernelName(configs -> kernel));
+
+	return buffer;
+}
+
+int kernelPageAction1(char* input, void* configSt) {
+
+	((Config *)configSt) -> kernel = KERNEL_AUTO;
+	return 0;
+}
+
+int kernelPageAction2(char* input, void* configSt) {
+
+	((Config *)configSt) -> kernel = KERNEL_GENERIC;
+	return 0;
+}
+
+int kernelPageAction3(char* input, void* configSt) {
+
+	((Config *)configSt) -> kernel = KERNEL_WIDE;
+	return 0;
+}
+
+char* pinningPageText(char* text, void* configSt) {
+
+	Config *configs = (Config *)configSt;
+	char* buffer = (char *)malloc(sizeof(char) * BUFFER_SIZE);
+
+	checkNullPointer((void*) buffer);
+	snprintf(buffer, BUFFER_SIZE, text, pinningName(configs -> pinning));
+
+	return buffer;
+}
+
+int pinningPageAction1(char* input, void* configSt) {
+
+	((Config *)configSt) -> pinning = PIN_NONE;
+	return 0;
+}
+
+int pinningPageAction2(char* input, void* configSt) {
+
+	((Config *)configSt) -> pinning = PIN_CORES;
+	return 0;
+}
+
+int pinningPageAction3(char* input, void* configSt) {
+
+	((Config *)configSt) -> pinning = PIN_CPUS;
 	return 0;
 }
+
+char* schedulerPageText(char* text, void* configSt) {
+
+	Config *configs = (Config *)configSt;
+	char* buffer = (char *)malloc(sizeof(char) * BUFFER_SIZE);
+
+	checkNullPointer((void*) buffer);
+	snprintf(buffer, BUFFER_SIZE, text, schedulerName(configs -> scheduler));
+
+	return buffer;
+}
+
+int schedulerPageAction1(char* input, void* configSt) {
+
+	((Config *)configSt) -> scheduler = SCHED_WEIGHTED;
+	return 0;
+}
+
+int schedulerPageAction2(char* input, void* configSt) {
+
+	((Config *)configSt) -> scheduler = SCHED_EQUAL;
+	return 0;
+}
+
+int schedulerPageAction3(char* input, void* configSt) {
+
+	((Config *)configSt) -> scheduler = SCHED_STATIC;
+	return 0;
+}
+
+void freePages(MenuSt* menu) {
+
+	freeComputations();
+	freeMenu(menu);
+}
@@ -0,0 +1,430 @@
+/*-----------------------------------------------------------------*/
+/**
+  @file   range.c
+  @author Flávio M.
+  @brief  Extraction of Digit Ranges Into Memory-Mapped Files.
+ */
+/*-----------------------------------------------------------------*/
+
+/*-----------------------------------------------------------------
+                              Includes
+  -----------------------------------------------------------------*/
+#include <fcntl.h>
+#include <math.h>
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "../include/bbp.h"
+#include "../include/error-handler.h"
+#include "../include/formula.h"
+#include "../include/job.h"
+#include "../include/output.h"
+#include "../include/range.h"
+#include "../include/timer.h"
+
+
+/*-----------------------------------------------------------------
+                            Definitions
+-----------------------------------------------------------------*/
+#define WINDOW_DIGITS 8       // Hex Digits Written Per Window
+#define OCT_WINDOW_DIGITS 6   // Hex Digits Per Window in Octal (24 Bits)
+#define DONE_SUFFIX ".done"   // Suffix of Finished Windows Map
+#define CHECKPOINT_WINDOWS 1024 // Windows Written Between Syncs of The Output
+#define RANGE_MAGIC "PIBBPRNG"
+
+
+/*-----------------------------------------------------------------
+                          Structs and Enums
+-----------------------------------------------------------------*/
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief Header of Finished Windows Map, Identifies The Run So
+          Only The Same Range is Resumed.
+*/
+/*-----------------------------------------------------------------*/
+typedef struct {
+	char magic[8];                 // RANGE_MAGIC
+	uint64_t startPos;             // First Digit
+	uint64_t totalDigits;          // Hex Digits in Range
+	uint32_t format;               // DigitFormat of Output
+	char key[FORMULA_KEY_SIZE];    // Key of Formula Used
+} RangeHeader;
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief State of a Range Extraction, Shared by its Workers.
+*/
+/*-----------------------------------------------------------------*/
+typedef struct {
+	Config configs;          // Configuration of a Single Window
+	DigitFormat format;      // Format of Output
+	uint64_t startPos;       // First Digit of Range
+	uint64_t windowDigits;   // Hex Digits Per Window
+	uint64_t windowSize;     // Bytes Per Window in Output
+	uint64_t totalWindows;   // Windows in Range
+	uint64_t fileSize;       // Bytes of Output
+
+	uint8_t* data;           // Mapped Output File
+	uint8_t* done;           // Mapped Finished Windows (After Header)
+
+	pthread_mutex_t windowMutex;
+	uint64_t nextWindow;     // Next Window to be Claimed
+	uint64_t extraRuns;      // Runs For Digits Past an Error Bound
+	uint64_t uncertain;      // Digits Written Without Guarantee
+	bool failed;             // A Window Couldn't be Computed, Workers Stop
+
+	uint64_t finished[CHECKPOINT_WINDOWS]; // Written, Not Yet Marked Done
+	uint32_t totalFinished;
+} RangeJob;
+
+
+/*-----------------------------------------------------------------
+                   Internal Functions Signatures
+  -----------------------------------------------------------------*/
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Open (or Create) a File and Map it in Memory. The File is
+           Preallocated With The Requested Size When its Current
+           Size is Different.
+   @param  const char* Path of File.
+   @param  size_t      Size of File.
+   @param  bool*       If The File Already Had The Requested Size.
+   @return void*       Mapped File / NULL on Error.
+*/
+/*-----------------------------------------------------------------*/
+void* mapFile(const char*, size_t, bool*);
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Worker That Claims Windows, Computes Them and Writes Their
+           Digits Straight to Their Position in The Output. Digits of
+           a Window Past The Error Bound of a Run Are Computed Again,
+           Starting at Their Own Offset.
+   @param  void* Pointer to RangeJob.
+   @return void* Null Pointer.
+*/
+/*-----------------------------------------------------------------*/
+void* rangeWorker(void*);
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Sync The Output, Then Mark Windows Written Before as Done,
+           so a Resume Never Skips a Window Whose Digits Aren't on
+           Disk.
+   @param  RangeJob*       State of Range.
+   @param  const uint64_t* Written Windows.
+   @param  uint32_t        Number of Windows.
+*/
+/*-----------------------------------------------------------------*/
+void checkpointWindows(RangeJob*, const uint64_t*, uint32_t);
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Bytes Used by a Number of Hex Digits in a Format.
+   @param  uint64_t    Number of Hex Digits.
+   @param  DigitFormat Format of Output.
+   @return uint64_t    Size in Bytes.
+*/
+/*-----------------------------------------------------------------*/
+uint64_t digitsSize(uint64_t, DigitFormat);
+
+
+/*-----------------------------------------------------------------
+                      Functions Implementation
+  -----------------------------------------------------------------*/
+void checkpointWindows(RangeJob* job, const uint64_t* windows, uint32_t total) {
+
+	msync(job -> data, job -> fileSize, MS_SYNC);
+
+	for (uint32_t i = 0; i < total; i++)
+		job -> done[windows[i]] = 1;
+}
+
+uint64_t digitsSize(uint64_t hexDigits, DigitFormat format) {
+
+	// Strings Don't Need The Null Terminator in The File
+	if (format == DIGITS_RAW)
+		return formattedSize(hexDigits * 4, format);
+
+	return formattedSize(hexDigits * 4, format) - 1;
+}
+
+void* mapFile(const char* path, size_t size, bool* existed) {
+
+	struct stat st;
+	void* map;
+	int fd = open(path, O_RDWR | O_CREAT, 0644);
+
+	if (fd == -1)
+		return NULL;
+
+	if (fstat(fd, &st)) {
+		close(fd);
+		return NULL;
+	}
+
+	*existed = ((size_t) st.st_size == size);
+
+	if (!*existed) {
+
+		// Discard Old Content, Reserve Blocks For The Whole File
+		if (ftruncate(fd, 0) ||
+		    (posix_fallocate(fd, 0, size) && ftruncate(fd, size))) {
+			close(fd);
+			return NULL;
+		}
+	}
+
+	map = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	close(fd);
+
+	return (map == MAP_FAILED) ? NULL : map;
+}
+
+void* rangeWorker(void* arg) {
+
+	RangeJob* job = (RangeJob*) arg;
+	Config configs = job -> configs;
+	BBPStats stats;
+	uint8_t bytes[FRACTION_BYTES];
+	char buffer[FRACTION_BYTES * 8 + 1];
+	uint64_t checkpoint[CHECKPOINT_WINDOWS];
+
+	while (true) {
+		uint64_t window, offset, size, bits = 0, have = 0;
+		uint64_t extraRuns = 0, uncertain = 0;
+		uint32_t pending = 0;
+		long double result;
+
+		pthread_mutex_lock(&job -> windowMutex);
+		window = (job -> failed) ? job -> totalWindows : job -> nextWindow++;
+		pthread_mutex_unlock(&job -> windowMutex);
+
+		if (window >= job -> totalWindows)
+			break;
+
+		// Finished in a Previous Run
+		if (job -> done[window])
+			continue;
+
+		while (have < job -> windowDigits) {
+			uint64_t take, value = 0;
+
+			configs.startPos = job -> startPos + window * job -> windowDigits + have;
+			result = evalBBP(&configs, &stats);
+
+			if (isnan(result))
+				break;
+
+			take = stats.guaranteedDigits;
+			extraRuns += (have > 0);
+
+			// Bound Crosses a Digit Boundary, Next Run Would be The Same
+			if (!take) {
+				take = 1;
+				uncertain++;
+			}
+
+			if (take > job -> windowDigits - have)
+				take = job -> windowDigits - have;
+
+			packFraction(result, bytes, FRACTION_BYTES);
+
+			for (int i = 0; i < FRACTION_BYTES; i++)
+				value = (value << 8) | bytes[i];
+
+			bits = (bits << (4 * take)) | (value >> (64 - 4 * take));
+			have += take;
+		}
+
+		// Window is Left Unfinished, Other Workers Stop
+		if (have < job -> windowDigits) {
+			pthread_mutex_lock(&job -> windowMutex);
+			job -> failed = true;
+			pthread_mutex_unlock(&job -> windowMutex);
+			break;
+		}
+
+		// Window Digits Packed Most Significant First
+		bits <<= 64 - 4 * job -> windowDigits;
+
+		for (int i = 0; i < FRACTION_BYTES; i++)
+			bytes[i] = bits >> (56 - 8 * i);
+
+		formatDigits(bytes, job -> windowDigits * 4, job -> format,
+		             buffer, sizeof(buffer));
+
+		// Last Window May Be Partial
+		offset = window * job -> windowSize;
+		size = job -> fileSize - offset;
+
+		if (size > job -> windowSize)
+			size = job -> windowSize;
+
+		memcpy(job -> data + offset, buffer, size);
+
+		pthread_mutex_lock(&job -> windowMutex);
+		job -> extraRuns += extraRuns;
+		job -> uncertain += uncertain;
+		job -> finished[job -> totalFinished++] = window;
+
+		// Full List is Taken by This Worker, The Others Start a New One
+		if (job -> totalFinished == CHECKPOINT_WINDOWS) {
+			memcpy(checkpoint, job -> finished, sizeof(checkpoint));
+			job -> totalFinished = 0;
+			pending = CHECKPOINT_WINDOWS;
+		}
+
+		pthread_mutex_unlock(&job -> windowMutex);
+
+		if (pending)
+			checkpointWindows(job, checkpoint, pending);
+	}
+
+	return NULL;
+}
+
+int calcRange(Config* currConfigs, uint64_t totalDigits,
+              DigitFormat format, const char* path) {
+
+	RangeJob job;
+	BBPJob check;
+	Config last;
+	RangeHeader header, *mappedHeader;
+	const Formula* formula = getFormula(currConfigs -> algo);
+	char* donePath;
+	size_t doneSize;
+	bool dataExisted, doneExisted;
+	uint64_t resumed = 0;
+	uint16_t nthreads = (currConfigs -> nthreads) ? currConfigs -> nthreads : 1;
+	pthread_t workers[nthreads];
+	MyTimer* total = NULL;
+
+	if (!formula || !totalDigits) {
+		invalidArgumentException("Invalid Algorithm or Number of Digits!");
+		return 1;
+	}
+
+	memset(&job, 0, sizeof(RangeJob));
+	job.configs = *currConfigs;
+	job.configs.nthreads = 1;
+	job.format = format;
+	job.startPos = currConfigs -> startPos;
+	job.windowDigits = (format == DIGITS_OCT) ? OCT_WINDOW_DIGITS : WINDOW_DIGITS;
+	job.configs.digits = job.windowDigits;
+	job.windowSize = digitsSize(job.windowDigits, format);
+	job.totalWindows = (totalDigits + job.windowDigits - 1) / job.windowDigits;
+	job.fileSize = digitsSize(totalDigits, format);
+
+	// Last Run Has The Largest Offset, if it Fits Every Run Does
+	last = job.configs;
+	last.startPos = job.startPos + job.totalWindows * job.windowDigits - 1;
+
+	if (last.startPos < job.startPos || initJob(&check, &last)) {
+		invalidArgumentException("Algorithm Not Found or Offset Too Large For Formula!");
+		return 1;
+	}
+
+	memset(&header, 0, sizeof(RangeHeader));
+	memcpy(header.magic, RANGE_MAGIC, sizeof(header.magic));
+	header.startPos = job.startPos;
+	header.totalDigits = totalDigits;
+	header.format = format;
+	snprintf(header.key, FORMULA_KEY_SIZE, "%s", formula -> key);
+
+	donePath = (char*) malloc(strlen(path) + sizeof(DONE_SUFFIX));
+	checkNullPointer((void*) donePath);
+	sprintf(donePath, "%s%s", path, DONE_SUFFIX);
+
+	doneSize = sizeof(RangeHeader) + job.totalWindows;
+	mappedHeader = (RangeHeader*) mapFile(donePath, doneSize, &doneExisted);
+	job.data = (uint8_t*) mapFile(path, job.fileSize, &dataExisted);
+
+	if (!mappedHeader || !job.data) {
+		perror("Couldn't Map Output Files");
+
+		if (mappedHeader)
+			munmap(mappedHeader, doneSize);
+
+		if (job.data)
+			munmap(job.data, job.fileSize);
+
+		free(donePath);
+		return 1;
+	}
+
+	job.done = (uint8_t*) (mappedHeader + 1);
+
+	// Only Resume The Same Range, Otherwise Start Over
+	if (doneExisted && dataExisted &&
+	    !memcmp(mappedHeader, &header, sizeof(RangeHeader))) {
+
+		for (uint64_t i = 0; i < job.totalWindows; i++)
+			resumed += job.done[i];
+	} else {
+		memset(job.done, 0, job.totalWindows);
+		memcpy(mappedHeader, &header, sizeof(RangeHeader));
+	}
+
+	INIT_TIMER(total);
+
+	pthread_mutex_init(&job.windowMutex, NULL);
+
+	for (int i = 0; i < nthreads; i++) {
+		if (pthread_create(workers + i, NULL, &rangeWorker, &job) != 0) {
+			unexpectedError("Error Creating Threads!");
+		}
+	}
+
+	for (int i = 0; i < nthreads; i++) {
+		if (pthread_join(workers[i], NULL) != 0) {
+			unexpectedError("Error Joining Threads!");
+		}
+	}
+
+	pthread_mutex_destroy(&job.windowMutex);
+
+	checkpointWindows(&job, job.finished, job.totalFinished);
+	munmap(job.data, job.fileSize);
+	msync(mappedHeader, doneSize, MS_SYNC);
+	munmap(mappedHeader, doneSize);
+
+	// Finished Windows Are Kept For a Resume
+	if (job.failed) {
+		fprintf(stderr, "\nRange Stopped, a Window Couldn't be Computed!\n");
+		free(donePath);
+		free(total);
+		return 1;
+	}
+
+	// Every Window is Finished, Map is No Longer Needed
+	unlink(donePath);
+	free(donePath);
+
+	END_TIMER(total);
+	CALC_FINAL_TIME(total);
+
+	printf("\n%lu digits @ %lu written to %s (%lu/%lu windows resumed)\n",
+	       totalDigits, job.startPos, path, resumed, job.totalWindows);
+	printf("Runs For Digits Past The Error Bound: %lu\n", job.extraRuns);
+
+	if (job.uncertain)
+		printf("[WARNING] %lu Digits Not Guaranteed (Too Close to a Digit Boundary)\n",
+		       job.uncertain);
+    printf("Total Exec. Time: %.5fs\n", total -> totalTime);
+	free(total);
+
+	return 0;
+}
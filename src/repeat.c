@@ -0,0 +1,150 @@
+/*-----------------------------------------------------------------*/
+/**
+  @file   repeat.c
+  @author Flávio M.
+  @brief  Repeated Computations With a Timing Summary.
+ */
+/*-----------------------------------------------------------------*/
+
+/*-----------------------------------------------------------------
+                              Includes
+  -----------------------------------------------------------------*/
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "../include/error-handler.h"
+#include "../include/bbp.h"
+#include "../include/output.h"
+#include "../include/repeat.h"
+#include "../include/report.h"
+
+
+/*-----------------------------------------------------------------
+                   Internal Functions Signatures
+  -----------------------------------------------------------------*/
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Compare Two Doubles (qsort).
+   @param  const void* First Double.
+   @param  const void* Second Double.
+   @return int         Comparison Result.
+*/
+/*-----------------------------------------------------------------*/
+int compareSeconds(const void*, const void*);
+
+
+/*-----------------------------------------------------------------
+                      Functions Implementation
+  -----------------------------------------------------------------*/
+int compareSeconds(const void* a, const void* b) {
+
+	double first = *(const double*) a, second = *(const double*) b;
+
+	return (first > second) - (first < second);
+}
+
+int summarizeTimes(double* times, uint32_t runs, TimingSummary* summary) {
+
+	double squares = 0.0, sum = 0.0;
+
+	if (!runs)
+		return 1;
+
+	qsort(times, runs, sizeof(double), compareSeconds);
+
+	for (uint32_t i = 0; i < runs; i++)
+		sum += times[i];
+
+	summary -> runs = runs;
+	summary -> min = times[0];
+	summary -> mean = sum / runs;
+
+	// Even Counts Take The Mean of Both Middle Runs
+	summary -> median = (runs % 2) ? times[runs / 2] :
+	                    (times[runs / 2 - 1] + times[runs / 2]) / 2.0;
+
+	// Nearest Rank: Smallest Time With at Least 90% of Runs Below or Equal
+	summary -> p90 = times[(9 * runs + 9) / 10 - 1];
+
+	for (uint32_t i = 0; i < runs; i++)
+		squares += (times[i] - summary -> mean) * (times[i] - summary -> mean);
+
+	summary -> stddev = (runs > 1) ? sqrt(squares / (runs - 1)) : 0.0;
+
+	return 0;
+}
+
+int calcRepeated(Config* currConfigs, uint32_t runs, uint32_t warmup) {
+
+	long double result = 0.0L, first = 0.0L;
+	uint8_t bytes[FRACTION_BYTES];
+	char digits[MAX_DIGITS + 1];
+	int precision = (currConfigs -> digits) ? currConfigs -> digits : PRECISION;
+	double* times;
+	TimingSummary summary = {0};
+	BBPStats stats;
+
+	if (!runs)
+		runs = 1;
+
+	if (precision > MAX_DIGITS)
+		precision = MAX_DIGITS;
+
+	times = (double*) malloc(runs * sizeof(double));
+	checkNullPointer((void*) times);
+
+	for (uint32_t i = 0; i < warmup + runs; i++) {
+		result = evalBBP(currConfigs, &stats);
+
+		if (isnan(result)) {
+			free(times);
+			return 1;
+		}
+
+		// Jobs Are Deterministic, Every Run Must Match
+		if (i && result != first)
+			fprintf(stderr, "\nRun %u Gave a Different Result!\n", i + 1);
+
+		first = (i) ? first : result;
+
+		if (i >= warmup)
+			times[i - warmup] = stats.totalTime;
+	}
+
+	summarizeTimes(times, runs, &summary);
+	free(times);
+
+	summary.warmup = warmup;
+
+	if (summary.median > 0.0) {
+		summary.termsPerSec = stats.terms / summary.median;
+		summary.digitsPerSec = precision / summary.median;
+	}
+
+	packFraction(result, bytes, (precision + 1) / 2);
+	formatDigits(bytes, precision * 4, DIGITS_HEX, digits, sizeof(digits));
+
+	if (stats.guaranteedDigits > precision)
+		stats.guaranteedDigits = precision;
+
+	if (currConfigs -> report != REPORT_TEXT)
+		return printTimingReport(stdout, currConfigs, &stats, digits, &summary);
+
+	if (stats.guaranteedDigits < precision)
+		printf("\n%d digits @ %lu = %.*s[%s]\n", precision, currConfigs -> startPos,
+		       stats.guaranteedDigits, digits, digits + stats.guaranteedDigits);
+	else
+		printf("\n%d digits @ %lu = %s\n", precision, currConfigs -> startPos, digits);
+
+	printf("Guaranteed: %d Digits (Error < %.2Le)\n", stats.guaranteedDigits,
+	       stats.errorBound);
+	printf("Runs: %u Timed, %u Warm-Up\n", summary.runs, summary.warmup);
+	printf("Min: %.5fs  Median: %.5fs  P90: %.5fs  Stddev: %.5fs\n",
+	       summary.min, summary.median, summary.p90, summary.stddev);
+	printf("Throughput: %.1f M Terms/s, %.1f Digits/s (Median)\n",
+	       summary.termsPerSec / 1e6, summary.digitsPerSec);
+
+	return 0;
+}
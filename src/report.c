@@ -0,0 +1,151 @@
+/*-----------------------------------------------------------------*/
+/**
+  @file   report.c
+  @author Flávio M.
+  @brief  Machine-Readable Records of Computations (JSON, CSV).
+ */
+/*-----------------------------------------------------------------*/
+
+/*-----------------------------------------------------------------
+                              Includes
+  -----------------------------------------------------------------*/
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include "../include/bbp.h"
+#include "../include/formula.h"
+#include "../include/report.h"
+
+
+/*-----------------------------------------------------------------
+                            Definitions
+-----------------------------------------------------------------*/
+#define CSV_HEADER "algorithm,offset,threads,batchSize,digits,totalTime,leftTime,rightTime,termsPerSec,guaranteedDigits,errorBound"
+#define CSV_TIMING_HEADER "algorithm,offset,threads,batchSize,digits,runs,warmup,minTime,medianTime,p90Time,meanTime,stddevTime,termsPerSec,digitsPerSec,guaranteedDigits,errorBound"
+
+
+/*-----------------------------------------------------------------
+                   Internal Functions Signatures
+  -----------------------------------------------------------------*/
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Print a String Quoted, Escaping Quotes (And Backslashes
+           in JSON). User Formulas May Have Any Key.
+   @param  FILE*        Output Stream.
+   @param  const char*  String to be Printed.
+   @param  ReportFormat Format of Record.
+*/
+/*-----------------------------------------------------------------*/
+void printQuoted(FILE*, const char*, ReportFormat);
+
+
+/*-----------------------------------------------------------------
+                      Functions Implementation
+  -----------------------------------------------------------------*/
+void printQuoted(FILE* stream, const char* str, ReportFormat format) {
+
+	fputc('"', stream);
+
+	for (; *str; str++) {
+
+		if (*str == '"')
+			fputc((format == REPORT_CSV) ? '"' : '\\', stream);
+		else if (*str == '\\' && format == REPORT_JSON)
+			fputc('\\', stream);
+
+		fputc(*str, stream);
+	}
+
+	fputc('"', stream);
+}
+
+int printReport(FILE* stream, const Config* configs,
+                const BBPStats* stats, const char* digits) {
+
+	const Formula* formula = getFormula(configs -> algo);
+	double termsPerSec = 0.0;
+	int guaranteed = stats -> guaranteedDigits;
+
+	if (!formula || configs -> report == REPORT_TEXT)
+		return 1;
+
+	if (stats -> totalTime > 0.0)
+		termsPerSec = stats -> terms / stats -> totalTime;
+
+	// Counted Only Over The Digits Printed
+	if (guaranteed > (int) strlen(digits))
+		guaranteed = strlen(digits);
+
+	if (configs -> report == REPORT_JSON) {
+		fputs("{\"algorithm\":", stream);
+		printQuoted(stream, formula -> key, REPORT_JSON);
+		fprintf(stream, ",\"offset\":%lu,\"threads\":%u,\"batchSize\":%lu,"
+		        "\"digits\":\"%s\",\"totalTime\":%.9f,\"leftTime\":%.9f,"
+		        "\"rightTime\":%.9f,\"termsPerSec\":%.1f,"
+		        "\"guaranteedDigits\":%d,\"errorBound\":%.3Le}\n",
+		        configs -> startPos, configs -> nthreads, stats -> batchSize,
+		        digits, stats -> totalTime, stats -> leftTime,
+		        stats -> rightTime, termsPerSec, guaranteed, stats -> errorBound);
+	} else {
+		fputs(CSV_HEADER "\n", stream);
+		printQuoted(stream, formula -> key, REPORT_CSV);
+		fprintf(stream, ",%lu,%u,%lu,%s,%.9f,%.9f,%.9f,%.1f,%d,%.3Le\n",
+		        configs -> startPos, configs -> nthreads, stats -> batchSize,
+		        digits, stats -> totalTime, stats -> leftTime,
+		        stats -> rightTime, termsPerSec, guaranteed, stats -> errorBound);
+	}
+
+	return ferror(stream) != 0;
+}
+
+int printTimingReport(FILE* stream, const Config* configs, const BBPStats* stats,
+                      const char* digits, const TimingSummary* summary) {
+
+	const Formula* formula = getFormula(configs -> algo);
+	int guaranteed = stats -> guaranteedDigits;
+
+	if (!formula || configs -> report == REPORT_TEXT)
+		return 1;
+
+	if (guaranteed > (int) strlen(digits))
+		guaranteed = strlen(digits);
+
+	if (configs -> report == REPORT_JSON) {
+		fputs("{\"algorithm\":", stream);
+		printQuoted(stream, formula -> key, REPORT_JSON);
+		fprintf(stream, ",\"offset\":%lu,\"threads\":%u,\"batchSize\":%lu,"
+		        "\"digits\":\"%s\",\"runs\":%u,\"warmup\":%u,\"minTime\":%.9f,"
+		        "\"medianTime\":%.9f,\"p90Time\":%.9f,\"meanTime\":%.9f,"
+		        "\"stddevTime\":%.9f,\"termsPerSec\":%.1f,\"digitsPerSec\":%.1f,"
+		        "\"guaranteedDigits\":%d,\"errorBound\":%.3Le}\n",
+		        configs -> startPos, configs -> nthreads, stats -> batchSize, digits,
+		        summary -> runs, summary -> warmup, summary -> min, summary -> median,
+		        summary -> p90, summary -> mean, summary -> stddev, summary -> termsPerSec,
+		        summary -> digitsPerSec, guaranteed, stats -> errorBound);
+	} else {
+		fputs(CSV_TIMING_HEADER "\n", stream);
+		printQuoted(stream, formula -> key, REPORT_CSV);
+		fprintf(stream, ",%lu,%u,%lu,%s,%u,%u,%.9f,%.9f,%.9f,%.9f,%.9f,%.1f,%.1f,%d,%.3Le\n",
+		        configs -> startPos, configs -> nthreads, stats -> batchSize, digits,
+		        summary -> runs, summary -> warmup, summary -> min, summary -> median,
+		        summary -> p90, summary -> mean, summary -> stddev, summary -> termsPerSec,
+		        summary -> digitsPerSec, guaranteed, stats -> errorBound);
+	}
+
+	return ferror(stream) != 0;
+}
+
+int parseReportFormat(const char* name, ReportFormat* format) {
+
+	static const char* names[] = {"text", "json", "csv"};
+
+	for (int i = 0; i < 3; i++) {
+		if (!strcmp(name, names[i])) {
+			*format = (ReportFormat) i;
+			return 0;
+		}
+	}
+
+	return 1;
+}
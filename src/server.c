@@ -0,0 +1,785 @@
+/*-----------------------------------------------------------------*/
+/**
+  @file   server.c
+  @author Flávio M.
+  @brief  Digit Server Over a Unix Domain Socket, and its Client.
+ */
+/*-----------------------------------------------------------------*/
+
+/*-----------------------------------------------------------------
+                              Includes
+  -----------------------------------------------------------------*/
+#include <errno.h>
+#include <inttypes.h>
+#include <math.h>
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <time.h>
+#include <unistd.h>
+#include "../include/async.h"
+#include "../include/bbp.h"
+#include "../include/error-handler.h"
+#include "../include/formula.h"
+#include "../include/output.h"
+#include "../include/server.h"
+
+
+/*-----------------------------------------------------------------
+                            Definitions
+-----------------------------------------------------------------*/
+#define WINDOW_DIGITS 8            // Hex Digits Per Cached Window
+#define DEFAULT_DIGITS 8           // Digits of Request Without Count
+#define MAX_REQUEST_DIGITS 4096    // Largest Digit Count of a Request
+#define CACHE_ENTRIES 65536        // Windows in Result Cache (Power of 2)
+#define LATENCY_SAMPLES 4096       // Latest Latencies Kept For Percentiles
+#define MAX_CLIENTS 256            // Simultaneous Connections
+#define LINE_SIZE 256              // Longest Request Line
+#define RESPONSE_SIZE (MAX_REQUEST_DIGITS + 64)
+
+
+/*-----------------------------------------------------------------
+                          Structs and Enums
+-----------------------------------------------------------------*/
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief Cached Window, 8 Hex Digits Starting at window * 8.
+*/
+/*-----------------------------------------------------------------*/
+typedef struct {
+	uint64_t window;
+	uint32_t algo;
+	uint32_t digits;
+	bool valid;
+} CacheEntry;
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief Window Being Computed, Shared by Every Request Wanting it.
+          The Last Request to Read it Caches it and Frees The Future.
+          The First Request Reading it Completes The Window Digits,
+          The Others Wait on ready.
+*/
+/*-----------------------------------------------------------------*/
+typedef struct pendingWindow {
+	uint64_t window;
+	uint32_t algo;
+	uint32_t refs;
+	BBPFuture* future;
+	uint32_t digits;
+	bool complete;            // Digits Set, Every Digit Within The Bound
+	bool completing;          // A Request is Completing The Digits
+	bool failed;              // Digits Couldn't be Completed
+	pthread_cond_t ready;     // Signaled When Completing Ends
+	struct pendingWindow* next;
+} PendingWindow;
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief State of Server, Guarded by its Mutex.
+*/
+/*-----------------------------------------------------------------*/
+typedef struct {
+	int listenFd;
+	bool running;
+	pthread_mutex_t mutex;
+	pthread_cond_t idle;                   // Signaled When a Client Leaves
+
+	CacheEntry* cache;
+	PendingWindow* pending;
+	int clients[MAX_CLIENTS];              // Connected Sockets (-1 = Free)
+	int totalClients;
+
+	uint64_t requests, hits, misses, shared, errors, computed;
+	uint64_t extraRuns, uncertain;         // Runs Completing Windows, Unbounded Digits
+	double queueTime;                      // Sum Over Computed Windows
+	double latencies[LATENCY_SAMPLES];     // Seconds, Ring Buffer
+} Server;
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief Arguments of a Client Thread.
+*/
+/*-----------------------------------------------------------------*/
+typedef struct {
+	Server* server;
+	int slot;
+} Connection;
+
+
+/*-----------------------------------------------------------------
+                   Internal Functions Signatures
+  -----------------------------------------------------------------*/
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Serve Requests of a Connection Until it Closes.
+   @param  void* Pointer to Connection.
+   @return void* Null Pointer.
+*/
+/*-----------------------------------------------------------------*/
+void* serveClient(void*);
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Answer One Request Line.
+   @param  Server*     State of Server.
+   @param  char*       Request Line.
+   @param  char*       Response Buffer (RESPONSE_SIZE Bytes).
+   @return int         Error(1) /Success(0) Code in Operation.
+*/
+/*-----------------------------------------------------------------*/
+int handleRequest(Server*, char*, char*);
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Compute (or Fetch) The Windows Covering a Digit Range and
+           Write its Hex Digits.
+   @param  Server*  State of Server.
+   @param  int      Algorithm Index.
+   @param  uint64_t First Digit.
+   @param  uint64_t Number of Digits.
+   @param  char*    Output (digits + 1 Bytes).
+   @return int      Error(1) /Success(0) Code in Operation.
+*/
+/*-----------------------------------------------------------------*/
+int fetchDigits(Server*, int, uint64_t, uint64_t, char*);
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Write Server Counters and Latency Percentiles.
+   @param  Server* State of Server.
+   @param  char*   Response Buffer.
+*/
+/*-----------------------------------------------------------------*/
+void writeStats(Server*, char*);
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Slot of a Window in The Result Cache.
+   @param  int       Algorithm Index.
+   @param  uint64_t  Window.
+   @return uint64_t  Index in Cache.
+*/
+/*-----------------------------------------------------------------*/
+static inline uint64_t cacheSlot(int, uint64_t);
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  First 8 Hex Digits of a Result.
+   @param  long double Result of a Window.
+   @return uint32_t    Digits, Most Significant First.
+*/
+/*-----------------------------------------------------------------*/
+static inline uint32_t packWindow(long double);
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Digits of a Window Within The Error Bound. Digits Past The
+           Guaranteed Prefix of The First Result Are Computed Again
+           on The Pool, Starting at The First Digit Not Guaranteed Yet.
+   @param  Server*     State of Server (Unlocked).
+   @param  int         Algorithm Index.
+   @param  uint64_t    Window.
+   @param  long double Result at Start of Window.
+   @param  int         Guaranteed Digits of Result.
+   @param  uint32_t*   Digits, Most Significant First.
+   @return int         Error(1) /Success(0) Code in Operation.
+*/
+/*-----------------------------------------------------------------*/
+int completeWindow(Server*, int, uint64_t, long double, int, uint32_t*);
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Fill a Socket Address, Checking The Path Length.
+   @param  struct sockaddr_un* Address.
+   @param  const char*         Path of Socket.
+   @return int                 Error(1) /Success(0) Code in Operation.
+*/
+/*-----------------------------------------------------------------*/
+int socketAddress(struct sockaddr_un*, const char*);
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Compare Two Doubles (qsort).
+*/
+/*-----------------------------------------------------------------*/
+int compareDoubles(const void*, const void*);
+
+
+/*-----------------------------------------------------------------
+                      Functions Implementation
+  -----------------------------------------------------------------*/
+static inline uint64_t cacheSlot(int algo, uint64_t window) {
+
+	// Fibonacci Hashing, Consecutive Windows Spread Over The Cache
+	return ((window ^ ((uint64_t) algo << 56)) * 0x9E3779B97F4A7C15ULL) >>
+	       (64 - __builtin_ctz(CACHE_ENTRIES));
+}
+
+static inline uint32_t packWindow(long double result) {
+
+	uint8_t bytes[4];
+
+	packFraction(result, bytes, 4);
+
+	return (uint32_t) bytes[0] << 24 | (uint32_t) bytes[1] << 16 |
+	       (uint32_t) bytes[2] << 8 | bytes[3];
+}
+
+int compareDoubles(const void* a, const void* b) {
+
+	double x = *(const double*) a, y = *(const double*) b;
+
+	return (x > y) - (x < y);
+}
+
+int socketAddress(struct sockaddr_un* address, const char* path) {
+
+	memset(address, 0, sizeof(struct sockaddr_un));
+	address -> sun_family = AF_UNIX;
+
+	if (strlen(path) >= sizeof(address -> sun_path)) {
+		fprintf(stderr, "Socket Path Too Long!\n");
+		return 1;
+	}
+
+	strcpy(address -> sun_path, path);
+
+	return 0;
+}
+
+int completeWindow(Server* server, int algo, uint64_t window, long double result,
+                   int guaranteed, uint32_t* digits) {
+
+	Config configs = {0, 1, algo, REPORT_TEXT, WINDOW_DIGITS};
+	BBPStats stats;
+	BBPFuture* future;
+	FutureState state;
+	uint64_t bits = 0, extraRuns = 0, uncertain = 0;
+	int have = 0;
+
+	while (true) {
+		int take = guaranteed;
+
+		// Bound Crosses a Digit Boundary, Next Run Would be The Same
+		if (!take) {
+			take = 1;
+			uncertain++;
+		}
+
+		if (take > WINDOW_DIGITS - have)
+			take = WINDOW_DIGITS - have;
+
+		bits = (bits << (4 * take)) | (packWindow(result) >> (32 - 4 * take));
+		have += take;
+
+		if (have == WINDOW_DIGITS)
+			break;
+
+		configs.startPos = window * WINDOW_DIGITS + have;
+		future = submitBBP(&configs, NULL, NULL, NULL);
+		extraRuns++;
+
+		if (!future)
+			return 1;
+
+		state = waitBBP(future, &result);
+		statsBBP(future, &stats);
+		freeFuture(future);
+
+		if (state != FUTURE_DONE)
+			return 1;
+
+		guaranteed = stats.guaranteedDigits;
+	}
+
+	pthread_mutex_lock(&server -> mutex);
+	server -> extraRuns += extraRuns;
+	server -> uncertain += uncertain;
+	pthread_mutex_unlock(&server -> mutex);
+
+	*digits = (uint32_t) bits;
+
+	return 0;
+}
+
+int fetchDigits(Server* server, int algo, uint64_t offset, uint64_t digits, char* out) {
+
+	static const char hex[] = "0123456789ABCDEF";
+	uint64_t first = offset / WINDOW_DIGITS;
+	uint64_t totalWindows = (offset + digits - 1) / WINDOW_DIGITS - first + 1;
+	uint32_t values[totalWindows];
+	PendingWindow* waits[totalWindows];
+	Config configs = {0, 1, algo, REPORT_TEXT, WINDOW_DIGITS};
+	int failed = 0;
+
+	memset(waits, 0, sizeof(waits));
+	pthread_mutex_lock(&server -> mutex);
+
+	// Every Missing Window is Submitted Before Waiting on Any
+	for (uint64_t i = 0; i < totalWindows && !failed; i++) {
+		uint64_t window = first + i;
+		CacheEntry* entry = server -> cache + cacheSlot(algo, window);
+		PendingWindow* pending;
+
+		if (entry -> valid && entry -> window == window && entry -> algo == (uint32_t) algo) {
+			values[i] = entry -> digits;
+			server -> hits++;
+			continue;
+		}
+
+		for (pending = server -> pending; pending; pending = pending -> next)
+			if (pending -> window == window && pending -> algo == (uint32_t) algo)
+				break;
+
+		if (pending) {
+			pending -> refs++;
+			server -> shared++;
+			waits[i] = pending;
+			continue;
+		}
+
+		configs.startPos = window * WINDOW_DIGITS;
+		pending = (PendingWindow*) malloc(sizeof(PendingWindow));
+		checkNullPointer((void*) pending);
+
+		*pending = (PendingWindow) {.window = window, .algo = algo, .refs = 1,
+		                            .future = submitBBP(&configs, NULL, NULL, NULL),
+		                            .next = server -> pending};
+
+		if (!pending -> future) {
+			free(pending);
+			failed = 1;
+			break;
+		}
+
+		pthread_cond_init(&pending -> ready, NULL);
+		server -> pending = pending;
+		server -> misses++;
+		waits[i] = pending;
+	}
+
+	pthread_mutex_unlock(&server -> mutex);
+
+	// After a Failure, Windows Are Only Released (Cancelled if Unshared)
+	for (uint64_t i = 0; i < totalWindows; i++) {
+		PendingWindow** link;
+		PendingWindow* pending = waits[i];
+		long double result;
+
+		if (!pending)
+			continue;
+
+		// Only Digits Within The Error Bound Are Served or Cached
+		if (!failed && waitBBP(pending -> future, &result) == FUTURE_DONE) {
+			bool owner = false;
+
+			pthread_mutex_lock(&server -> mutex);
+
+			if (!pending -> complete && !pending -> completing && !pending -> failed)
+				owner = pending -> completing = true;
+
+			while (!owner && pending -> completing)
+				pthread_cond_wait(&pending -> ready, &server -> mutex);
+
+			pthread_mutex_unlock(&server -> mutex);
+
+			// Only One Request Completes a Window, Sharers Wait For it
+			if (owner) {
+				BBPStats stats;
+				uint32_t digits = 0;
+				int error;
+
+				statsBBP(pending -> future, &stats);
+				error = completeWindow(server, algo, pending -> window, result,
+				                       stats.guaranteedDigits, &digits);
+
+				pthread_mutex_lock(&server -> mutex);
+				pending -> digits = digits;
+				pending -> complete = !error;
+				pending -> failed = error;
+				pending -> completing = false;
+				pthread_cond_broadcast(&pending -> ready);
+				pthread_mutex_unlock(&server -> mutex);
+			}
+
+			pthread_mutex_lock(&server -> mutex);
+			values[i] = pending -> digits;
+			failed = !pending -> complete;
+		} else {
+			failed = 1;
+			pthread_mutex_lock(&server -> mutex);
+		}
+
+		if (--pending -> refs) {
+			pthread_mutex_unlock(&server -> mutex);
+			continue;
+		}
+
+		if (pending -> complete) {
+			BBPStats stats;
+
+			server -> cache[cacheSlot(algo, pending -> window)] =
+				(CacheEntry) {pending -> window, algo, pending -> digits, true};
+
+			statsBBP(pending -> future, &stats);
+			server -> queueTime += stats.queueTime;
+			server -> computed++;
+		}
+
+		for (link = &server -> pending; *link != pending; link = &(*link) -> next);
+		*link = pending -> next;
+
+		pthread_mutex_unlock(&server -> mutex);
+		freeFuture(pending -> future);
+		pthread_cond_destroy(&pending -> ready);
+		free(pending);
+	}
+
+	if (failed)
+		return 1;
+
+	for (uint64_t i = 0; i < digits; i++) {
+		uint64_t pos = offset + i - first * WINDOW_DIGITS;
+
+		out[i] = hex[(values[pos / WINDOW_DIGITS] >> (28 - 4 * (pos % WINDOW_DIGITS))) & 0xF];
+	}
+
+	out[digits] = '\0';
+
+	return 0;
+}
+
+void writeStats(Server* server, char* response) {
+
+	uint64_t samples = server -> requests;
+	double sorted[LATENCY_SAMPLES];
+	double p50 = 0.0, p90 = 0.0, p99 = 0.0, max = 0.0;
+
+	if (samples > LATENCY_SAMPLES)
+		samples = LATENCY_SAMPLES;
+
+	if (samples) {
+		memcpy(sorted, server -> latencies, samples * sizeof(double));
+		qsort(sorted, samples, sizeof(double), &compareDoubles);
+
+		p50 = sorted[(samples - 1) * 50 / 100];
+		p90 = sorted[(samples - 1) * 90 / 100];
+		p99 = sorted[(samples - 1) * 99 / 100];
+		max = sorted[samples - 1];
+	}
+
+	snprintf(response, RESPONSE_SIZE,
+	         "OK requests=%" PRIu64 " errors=%" PRIu64 " hits=%" PRIu64 " misses=%" PRIu64
+	         " shared=%" PRIu64 " extra=%" PRIu64 " uncertain=%" PRIu64
+	         " p50=%.1fus p90=%.1fus p99=%.1fus max=%.1fus queue=%.1fus",
+	         server -> requests, server -> errors, server -> hits, server -> misses,
+	         server -> shared, server -> extraRuns, server -> uncertain, p50 * 1e6, p90 * 1e6, p99 * 1e6, max * 1e6,
+	         (server -> computed) ? server -> queueTime / server -> computed * 1e6 : 0.0);
+}
+
+int handleRequest(Server* server, char* line, char* response) {
+
+	char key[FORMULA_KEY_SIZE];
+	char end;
+	uint64_t offset, digits = DEFAULT_DIGITS;
+	int algo, fields;
+
+	fields = sscanf(line, "%31s %" SCNu64 " %" SCNu64 " %c", key, &offset, &digits, &end);
+
+	if (fields == 1 && !strcmp(key, "STATS")) {
+		pthread_mutex_lock(&server -> mutex);
+		writeStats(server, response);
+		pthread_mutex_unlock(&server -> mutex);
+		return 0;
+	}
+
+	if (fields == 1 && !strcmp(key, "SHUTDOWN")) {
+		pthread_mutex_lock(&server -> mutex);
+		server -> running = false;
+		shutdown(server -> listenFd, SHUT_RDWR);
+		pthread_mutex_unlock(&server -> mutex);
+		strcpy(response, "OK");
+		return 0;
+	}
+
+	if (fields < 2 || fields > 3) {
+		strcpy(response, "ERR Expected: <algorithm> <offset> [digits] | STATS | SHUTDOWN");
+		return 1;
+	}
+
+	algo = findFormula(key);
+
+	if (algo == -1) {
+		strcpy(response, "ERR Algorithm Not Found");
+		return 1;
+	}
+
+	if (!digits || digits > MAX_REQUEST_DIGITS || offset > UINT64_MAX - digits) {
+		sprintf(response, "ERR Digits Must Be 1-%d", MAX_REQUEST_DIGITS);
+		return 1;
+	}
+
+	strcpy(response, "OK ");
+
+	if (fetchDigits(server, algo, offset, digits, response + 3)) {
+		strcpy(response, "ERR Offset Too Large For Formula or Server Stopping");
+		return 1;
+	}
+
+	return 0;
+}
+
+void* serveClient(void* arg) {
+
+	Connection* connection = (Connection*) arg;
+	Server* server = connection -> server;
+	int fd = server -> clients[connection -> slot];
+	FILE* in = fdopen(fd, "r");
+	char line[LINE_SIZE];
+	char* response = (char*) malloc(RESPONSE_SIZE + 1);
+
+	checkNullPointer((void*) response);
+
+	while (in && fgets(line, LINE_SIZE, in)) {
+		struct timespec start, end;
+		size_t length;
+		int failed;
+
+		clock_gettime(CLOCK_MONOTONIC_RAW, &start);
+		failed = handleRequest(server, line, response);
+		clock_gettime(CLOCK_MONOTONIC_RAW, &end);
+
+		pthread_mutex_lock(&server -> mutex);
+		server -> latencies[server -> requests % LATENCY_SAMPLES] =
+			(end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+		server -> requests++;
+		server -> errors += failed;
+		pthread_mutex_unlock(&server -> mutex);
+
+		length = strlen(response);
+		response[length++] = '\n';
+
+		if (send(fd, response, length, MSG_NOSIGNAL) != (ssize_t) length)
+			break;
+	}
+
+	pthread_mutex_lock(&server -> mutex);
+	server -> clients[connection -> slot] = -1;
+	server -> totalClients--;
+	pthread_cond_signal(&server -> idle);
+	pthread_mutex_unlock(&server -> mutex);
+
+	if (in)
+		fclose(in);
+	else
+		close(fd);
+
+	free(response);
+	free(connection);
+
+	return NULL;
+}
+
+int runServer(const char* path, uint16_t nthreads) {
+
+	Server* server;
+	struct sockaddr_un address;
+	pthread_attr_t detached;
+
+	if (socketAddress(&address, path))
+		return 1;
+
+	server = (Server*) calloc(1, sizeof(Server));
+	checkNullPointer((void*) server);
+
+	server -> cache = (CacheEntry*) calloc(CACHE_ENTRIES, sizeof(CacheEntry));
+	checkNullPointer((void*) server -> cache);
+
+	for (int i = 0; i < MAX_CLIENTS; i++)
+		server -> clients[i] = -1;
+
+	server -> listenFd = socket(AF_UNIX, SOCK_STREAM, 0);
+
+	// Socket Left by a Previous Server is Replaced
+	unlink(path);
+
+	if (server -> listenFd == -1 ||
+	    bind(server -> listenFd, (struct sockaddr*) &address, sizeof(address)) ||
+	    listen(server -> listenFd, SOMAXCONN)) {
+		perror("Couldn't Open Socket");
+
+		if (server -> listenFd != -1)
+			close(server -> listenFd);
+
+		free(server -> cache);
+		free(server);
+		return 1;
+	}
+
+	pthread_mutex_init(&server -> mutex, NULL);
+	pthread_cond_init(&server -> idle, NULL);
+	server -> running = true;
+
+	// Pool Stays Warm Between Requests
+	initAsync(nthreads, PIN_NONE);
+
+	pthread_attr_init(&detached);
+	pthread_attr_setdetachstate(&detached, PTHREAD_CREATE_DETACHED);
+
+	printf("Serving on %s With %d Workers\n", path, nthreads);
+	fflush(stdout);
+
+	while (true) {
+		Connection* connection;
+		pthread_t thread;
+		int slot = 0;
+		int fd = accept(server -> listenFd, NULL, NULL);
+
+		pthread_mutex_lock(&server -> mutex);
+
+		if (!server -> running) {
+			pthread_mutex_unlock(&server -> mutex);
+
+			if (fd != -1)
+				close(fd);
+
+			break;
+		}
+
+		if (fd == -1) {
+			pthread_mutex_unlock(&server -> mutex);
+
+			if (errno != EINTR && errno != ECONNABORTED)
+				perror("Couldn't Accept Connection");
+
+			continue;
+		}
+
+		while (slot < MAX_CLIENTS && server -> clients[slot] != -1)
+			slot++;
+
+		if (slot == MAX_CLIENTS) {
+			pthread_mutex_unlock(&server -> mutex);
+			send(fd, "ERR Too Many Clients\n", 21, MSG_NOSIGNAL);
+			close(fd);
+			continue;
+		}
+
+		server -> clients[slot] = fd;
+		server -> totalClients++;
+		pthread_mutex_unlock(&server -> mutex);
+
+		connection = (Connection*) malloc(sizeof(Connection));
+		checkNullPointer((void*) connection);
+		*connection = (Connection) {server, slot};
+
+		if (pthread_create(&thread, &detached, &serveClient, connection) != 0) {
+			unexpectedError("Error Creating Threads!");
+		}
+	}
+
+	pthread_attr_destroy(&detached);
+
+	// Wake Clients Blocked on Reads, Then Wait Until Every One Left
+	pthread_mutex_lock(&server -> mutex);
+
+	for (int i = 0; i < MAX_CLIENTS; i++)
+		if (server -> clients[i] != -1)
+			shutdown(server -> clients[i], SHUT_RD);
+
+	while (server -> totalClients)
+		pthread_cond_wait(&server -> idle, &server -> mutex);
+
+	pthread_mutex_unlock(&server -> mutex);
+
+	freeAsync();
+	close(server -> listenFd);
+	unlink(path);
+
+	pthread_mutex_destroy(&server -> mutex);
+	pthread_cond_destroy(&server -> idle);
+	free(server -> cache);
+	free(server);
+
+	return 0;
+}
+
+int runClient(const char* path, const char* request) {
+
+	struct sockaddr_un address;
+	char line[LINE_SIZE];
+	char* response = (char*) malloc(RESPONSE_SIZE + 1);
+	FILE* in;
+	int fd, failed = 0;
+
+	checkNullPointer((void*) response);
+
+	if (socketAddress(&address, path)) {
+		free(response);
+		return 1;
+	}
+
+	fd = socket(AF_UNIX, SOCK_STREAM, 0);
+
+	if (fd == -1 || connect(fd, (struct sockaddr*) &address, sizeof(address))) {
+		perror("Couldn't Connect to Server");
+
+		if (fd != -1)
+			close(fd);
+
+		free(response);
+		return 1;
+	}
+
+	in = fdopen(fd, "r");
+	checkNullFilePointer(in);
+
+	while (request || fgets(line, LINE_SIZE, stdin)) {
+		size_t length;
+
+		if (request) {
+			snprintf(line, LINE_SIZE, "%s\n", request);
+		} else if (!strchr(line, '\n')) {
+			strcat(line, "\n");
+		}
+
+		length = strlen(line);
+
+		if (send(fd, line, length, MSG_NOSIGNAL) != (ssize_t) length ||
+		    !fgets(response, RESPONSE_SIZE + 1, in)) {
+			fprintf(stderr, "Connection Closed by Server!\n");
+			failed = 1;
+			break;
+		}
+
+		fputs(response, stdout);
+		failed |= !strncmp(response, "ERR", 3);
+
+		if (request)
+			break;
+	}
+
+	fclose(in);
+	free(response);
+
+	return failed;
+}
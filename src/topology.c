@@ -0,0 +1,377 @@
+/*-----------------------------------------------------------------*/
+/**
+  @file   topology.c
+  @author Flávio M.
+  @brief  Cores, SMT Siblings and Caches of The Machine From sysfs.
+ */
+/*-----------------------------------------------------------------*/
+
+/*-----------------------------------------------------------------
+                              Includes
+  -----------------------------------------------------------------*/
+#define _GNU_SOURCE
+#include <pthread.h>
+#include <sched.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "../include/topology.h"
+
+
+/*-----------------------------------------------------------------
+                            Definitions
+-----------------------------------------------------------------*/
+#define SYSFS_CPU "/sys/devices/system/cpu"
+#define ATOM_CPUS "/sys/devices/cpu_atom/cpus"   // Efficiency Cores of Hybrid x86
+#define EFFICIENCY_CAPACITY 80                   // Below This % of The Fastest, a Core is Efficiency
+#define LINE_SIZE 256
+
+
+/*-----------------------------------------------------------------
+                          Global Variables
+-----------------------------------------------------------------*/
+static Topology topology;
+static pthread_once_t topologyOnce = PTHREAD_ONCE_INIT;
+
+
+/*-----------------------------------------------------------------
+                   Internal Functions Signatures
+  -----------------------------------------------------------------*/
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Read The First Line of a sysfs File.
+   @param  const char* Path of File.
+   @param  char*       Line Read (Without Newline).
+   @param  size_t      Size of Line.
+   @return int         Error(1) /Success(0) Code in Operation.
+*/
+/*-----------------------------------------------------------------*/
+int readLine(const char*, char*, size_t);
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Read a Number From a sysfs File, With an Optional K
+           (Kilobytes) Suffix Left Out.
+   @param  const char* Path of File.
+   @param  long*       Number Read.
+   @return int         Error(1) /Success(0) Code in Operation.
+*/
+/*-----------------------------------------------------------------*/
+int readNumber(const char*, long*);
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Parse a sysfs CPU List ("0-3,8,10-11").
+   @param  const char* List.
+   @param  bool*       Marks For Each CPU in The List (MAX_CPUS).
+   @return int         Number of CPUs in The List.
+*/
+/*-----------------------------------------------------------------*/
+int parseCpuList(const char*, bool*);
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Read Every CPU The Process May Run On Into The Global
+           Topology. Run Once by getTopology.
+*/
+/*-----------------------------------------------------------------*/
+void readTopology();
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief Read The Data Caches of a CPU Into The Global Topology.
+   @param int Logical CPU Number.
+*/
+/*-----------------------------------------------------------------*/
+void readCaches(int);
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Order CPUs For Worker Threads: First Threads of Cores
+           Before Siblings, Then Faster Cores First (qsort).
+   @param  const void* First CpuInfo.
+   @param  const void* Second CpuInfo.
+   @return int         Comparison Result.
+*/
+/*-----------------------------------------------------------------*/
+int compareCpus(const void*, const void*);
+
+
+/*-----------------------------------------------------------------
+                      Functions Implementation
+  -----------------------------------------------------------------*/
+int readLine(const char* path, char* line, size_t size) {
+
+	FILE* file = fopen(path, "r");
+
+	if (!file)
+		return 1;
+
+	if (!fgets(line, size, file)) {
+		fclose(file);
+		return 1;
+	}
+
+	fclose(file);
+	line[strcspn(line, "\n")] = '\0';
+
+	return 0;
+}
+
+int readNumber(const char* path, long* number) {
+
+	char line[LINE_SIZE], *end;
+
+	if (readLine(path, line, sizeof(line)))
+		return 1;
+
+	*number = strtol(line, &end, 10);
+
+	return end == line || (*end != '\0' && *end != 'K');
+}
+
+int parseCpuList(const char* list, bool* marks) {
+
+	const char* p = list;
+	char* end;
+	int total = 0;
+
+	while (*p) {
+		long first = strtol(p, &end, 10), last = first;
+
+		if (end == p)
+			break;
+
+		if (*end == '-')
+			last = strtol(end + 1, &end, 10);
+
+		for (long cpu = first; cpu <= last && cpu < MAX_CPUS; cpu++) {
+			if (cpu >= 0 && !marks[cpu]) {
+				marks[cpu] = true;
+				total++;
+			}
+		}
+
+		p = (*end == ',') ? end + 1 : end;
+	}
+
+	return total;
+}
+
+void readCaches(int cpu) {
+
+	char path[LINE_SIZE], line[LINE_SIZE];
+	long level, size;
+
+	for (int index = 0; ; index++) {
+		bool shared[MAX_CPUS] = {false};
+
+		snprintf(path, sizeof(path), SYSFS_CPU "/cpu%d/cache/index%d/level", cpu, index);
+
+		if (readNumber(path, &level))
+			break;
+
+		// Instruction Caches Don't Hold The Summation Data
+		snprintf(path, sizeof(path), SYSFS_CPU "/cpu%d/cache/index%d/type", cpu, index);
+
+		if (readLine(path, line, sizeof(line)) || !strcmp(line, "Instruction"))
+			continue;
+
+		snprintf(path, sizeof(path), SYSFS_CPU "/cpu%d/cache/index%d/size", cpu, index);
+
+		if (level < 1 || level > MAX_CACHE_LEVELS || readNumber(path, &size))
+			continue;
+
+		topology.cacheKb[level - 1] = size;
+
+		snprintf(path, sizeof(path), SYSFS_CPU "/cpu%d/cache/index%d/shared_cpu_list", cpu, index);
+
+		if (!readLine(path, line, sizeof(line)))
+			topology.cacheShared[level - 1] = parseCpuList(line, shared);
+	}
+}
+
+void readTopology() {
+
+	static bool atom[MAX_CPUS];
+	char path[LINE_SIZE], line[LINE_SIZE];
+	long keys[MAX_CPUS], raw[MAX_CPUS], maxRaw = 0;
+	long configured = sysconf(_SC_NPROCESSORS_CONF);
+	long online = sysconf(_SC_NPROCESSORS_ONLN);
+	bool hasAtom = !readLine(ATOM_CPUS, line, sizeof(line));
+	bool hasMask;
+	cpu_set_t allowed;
+
+	CPU_ZERO(&allowed);
+	hasMask = !sched_getaffinity(0, sizeof(allowed), &allowed);
+
+	if (hasAtom)
+		parseCpuList(line, atom);
+
+	if (configured > MAX_CPUS)
+		configured = MAX_CPUS;
+
+	for (int id = 0; id < configured; id++) {
+		CpuInfo* cpu = topology.cpus + topology.total;
+		long package = 0, core = id, state;
+
+		if (hasMask ? !CPU_ISSET(id, &allowed) : id >= online)
+			continue;
+
+		// cpu0 Has no online File, it Can't be Taken Offline
+		snprintf(path, sizeof(path), SYSFS_CPU "/cpu%d/online", id);
+
+		if (!readNumber(path, &state) && !state)
+			continue;
+
+		snprintf(path, sizeof(path), SYSFS_CPU "/cpu%d/topology/physical_package_id", id);
+		readNumber(path, &package);
+		snprintf(path, sizeof(path), SYSFS_CPU "/cpu%d/topology/core_id", id);
+		readNumber(path, &core);
+
+		cpu -> id = id;
+		cpu -> core = -1;
+		cpu -> thread = 0;
+		keys[topology.total] = (package << 32) | core;
+
+		// SMT Siblings Share Package and Core IDs
+		for (int i = 0; i < topology.total; i++) {
+			if (keys[i] == keys[topology.total]) {
+				cpu -> core = topology.cpus[i].core;
+				cpu -> thread++;
+			}
+		}
+
+		if (cpu -> core == -1)
+			cpu -> core = topology.cores++;
+
+		// Capacity (ARM, Some x86) Else Maximum Frequency
+		snprintf(path, sizeof(path), SYSFS_CPU "/cpu%d/cpu_capacity", id);
+
+		if (readNumber(path, raw + topology.total)) {
+			snprintf(path, sizeof(path), SYSFS_CPU "/cpu%d/cpufreq/cpuinfo_max_freq", id);
+
+			if (readNumber(path, raw + topology.total))
+				raw[topology.total] = 0;
+		}
+
+		if (raw[topology.total] > maxRaw)
+			maxRaw = raw[topology.total];
+
+		topology.total++;
+	}
+
+	// No sysfs or Affinity: Every Online CPU Counts
+	if (!topology.total) {
+		topology.total = (online < 1) ? 1 : (online > MAX_CPUS) ? MAX_CPUS : online;
+		topology.cores = topology.total;
+
+		for (int id = 0; id < topology.total; id++) {
+			topology.cpus[id] = (CpuInfo) {id, id, 0, CORE_PERFORMANCE, FULL_CAPACITY};
+			raw[id] = 0;
+		}
+	}
+
+	for (int i = 0; i < topology.total; i++) {
+		CpuInfo* cpu = topology.cpus + i;
+
+		cpu -> capacity = (maxRaw && raw[i]) ? raw[i] * FULL_CAPACITY / maxRaw : FULL_CAPACITY;
+		cpu -> type = (atom[cpu -> id] ||
+		               cpu -> capacity * 100 < EFFICIENCY_CAPACITY * FULL_CAPACITY) ?
+		              CORE_EFFICIENCY : CORE_PERFORMANCE;
+
+		if (cpu -> type == CORE_EFFICIENCY)
+			topology.efficiency++;
+	}
+
+	readCaches(topology.cpus[0].id);
+}
+
+const Topology* getTopology() {
+
+	pthread_once(&topologyOnce, readTopology);
+
+	return &topology;
+}
+
+int pinAttribute(pthread_attr_t* attr, int cpu) {
+
+	cpu_set_t set;
+
+	CPU_ZERO(&set);
+	CPU_SET(cpu, &set);
+
+	return pthread_attr_setaffinity_np(attr, sizeof(set), &set) != 0;
+}
+
+int compareCpus(const void* a, const void* b) {
+
+	const CpuInfo* first = (const CpuInfo*) a;
+	const CpuInfo* second = (const CpuInfo*) b;
+
+	if (first -> thread != second -> thread)
+		return first -> thread - second -> thread;
+
+	if (first -> capacity != second -> capacity)
+		return (first -> capacity > second -> capacity) ? -1 : 1;
+
+	return first -> id - second -> id;
+}
+
+int selectCpus(const Topology* machine, bool physicalOnly, int* cpus,
+               uint32_t* capacities, int max) {
+
+	CpuInfo* order = (CpuInfo*) malloc(machine -> total * sizeof(CpuInfo));
+	int chosen = 0;
+
+	if (!order)
+		return 0;
+
+	memcpy(order, machine -> cpus, machine -> total * sizeof(CpuInfo));
+	qsort(order, machine -> total, sizeof(CpuInfo), compareCpus);
+
+	for (int i = 0; i < machine -> total && chosen < max; i++) {
+		if (physicalOnly && order[i].thread)
+			break;
+
+		cpus[chosen] = order[i].id;
+
+		if (capacities)
+			capacities[chosen] = order[i].capacity;
+
+		chosen++;
+	}
+
+	free(order);
+
+	return chosen;
+}
+
+void printTopology(const Topology* machine) {
+
+	printf("\nTopology: %d CPUs, %d Cores (%d Efficiency CPUs)\n",
+	       machine -> total, machine -> cores, machine -> efficiency);
+	printf("%-6s %-6s %-8s %-12s %s\n", "CPU", "Core", "Thread", "Type", "Capacity");
+
+	for (int i = 0; i < machine -> total; i++) {
+		const CpuInfo* cpu = machine -> cpus + i;
+
+		printf("%-6d %-6d %-8d %-12s %u\n", cpu -> id, cpu -> core, cpu -> thread,
+		       (cpu -> type == CORE_PERFORMANCE) ? "Performance" : "Efficiency",
+		       cpu -> capacity);
+	}
+
+	for (int level = 0; level < MAX_CACHE_LEVELS; level++)
+		if (machine -> cacheKb[level])
+			printf("L%d: %u KB (Shared by %d CPUs)\n", level + 1,
+			       machine -> cacheKb[level], machine -> cacheShared[level]);
+}
@@ -0,0 +1,300 @@
+/*-----------------------------------------------------------------*/
+/**
+  @file   tune.c
+  @author Flávio M.
+  @brief  Quick Benchmark Suggesting Settings For This Machine.
+ */
+/*-----------------------------------------------------------------*/
+
+/*-----------------------------------------------------------------
+                              Includes
+  -----------------------------------------------------------------*/
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "../include/bbp.h"
+#include "../include/formula.h"
+#include "../include/topology.h"
+#include "../include/tune.h"
+
+
+/*-----------------------------------------------------------------
+                            Definitions
+-----------------------------------------------------------------*/
+#define TUNE_MIN_OFFSET 100000    // Offsets Below Are Too Short to Time
+#define TUNE_MAX_OFFSET 1000000   // Offsets Above Take Too Long Per Run
+#define TUNE_RUNS 3               // Runs Per Candidate, Median is Kept
+#define MAX_CANDIDATES 16         // Values Tried For a Single Setting
+#define TUNE_MARGIN 0.98          // Candidates Must Beat The Best by 2% (Noise)
+
+
+/*-----------------------------------------------------------------
+                          Structs and Enums
+-----------------------------------------------------------------*/
+
+// Settings Swept, in Order
+typedef enum {
+	TUNE_THREADS,
+	TUNE_SCHEDULER,
+	TUNE_BATCH,
+	TUNE_KERNEL,
+	TUNE_PINNING,
+	TOTAL_TUNED
+}Tuned;
+
+
+/*-----------------------------------------------------------------
+                          Global Variables
+-----------------------------------------------------------------*/
+static const char* tunedNames[TOTAL_TUNED] = {"Threads", "Scheduler", "Batch Size",
+                                              "Kernel", "Pinning"};
+static const uint64_t batchSizes[] = {25, 50, 100, 200, 500, 1000};
+
+
+/*-----------------------------------------------------------------
+                   Internal Functions Signatures
+  -----------------------------------------------------------------*/
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Values Tried For a Setting.
+   @param  Tuned     Setting.
+   @param  uint64_t* Values (MAX_CANDIDATES).
+   @return int       Number of Values.
+*/
+/*-----------------------------------------------------------------*/
+int candidates(Tuned, uint64_t*);
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief Write a Value of a Setting Into a Config.
+   @param Config*  Configuration.
+   @param Tuned    Setting.
+   @param uint64_t Value.
+*/
+/*-----------------------------------------------------------------*/
+void applySetting(Config*, Tuned, uint64_t);
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief Write The Value of a Setting in a Config as Text.
+   @param const Config* Configuration.
+   @param Tuned         Setting.
+   @param char*         Buffer.
+   @param size_t        Size of Buffer.
+*/
+/*-----------------------------------------------------------------*/
+void settingText(const Config*, Tuned, char*, size_t);
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Median Time of TUNE_RUNS Runs of a Config.
+   @param  Config* Configuration.
+   @return double  Seconds / NAN if The Config Can't Run.
+*/
+/*-----------------------------------------------------------------*/
+double medianTime(Config*);
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Compare Two Doubles (qsort).
+   @param  const void* First Double.
+   @param  const void* Second Double.
+   @return int         Comparison Result.
+*/
+/*-----------------------------------------------------------------*/
+int compareTimes(const void*, const void*);
+
+
+/*-----------------------------------------------------------------
+                      Functions Implementation
+  -----------------------------------------------------------------*/
+int candidates(Tuned setting, uint64_t* values) {
+
+	int total = 0, cpus;
+
+	switch (setting) {
+		case TUNE_THREADS:
+			cpus = getTopology() -> total;
+
+			// Powers of Two Below The CPUs, Then Every CPU
+			for (int threads = 1; threads < cpus && total < MAX_CANDIDATES - 1; threads *= 2)
+				values[total++] = threads;
+
+			values[total++] = cpus;
+			break;
+		case TUNE_SCHEDULER:
+			for (int i = 0; i < TOTAL_SCHEDULERS; i++)
+				values[total++] = i;
+			break;
+		case TUNE_BATCH:
+			for (size_t i = 0; i < sizeof(batchSizes) / sizeof(batchSizes[0]); i++)
+				values[total++] = batchSizes[i];
+			break;
+		case TUNE_KERNEL:
+			for (int i = 0; i < TOTAL_KERNELS; i++)
+				values[total++] = i;
+			break;
+		case TUNE_PINNING:
+			for (int i = 0; i < TOTAL_PINNINGS; i++)
+				values[total++] = i;
+			break;
+		default:
+			break;
+	}
+
+	return total;
+}
+
+void applySetting(Config* configs, Tuned setting, uint64_t value) {
+
+	switch (setting) {
+		case TUNE_THREADS:
+			configs -> nthreads = value;
+			break;
+		case TUNE_SCHEDULER:
+			configs -> scheduler = (SchedulerMode) value;
+			break;
+		case TUNE_BATCH:
+			configs -> batchSize = value;
+			break;
+		case TUNE_KERNEL:
+			configs -> kernel = (KernelMode) value;
+			break;
+		case TUNE_PINNING:
+			configs -> pinning = (PinPolicy) value;
+			break;
+		default:
+			break;
+	}
+}
+
+void settingText(const Config* configs, Tuned setting, char* buffer, size_t size) {
+
+	switch (setting) {
+		case TUNE_THREADS:
+			snprintf(buffer, size, "%d", configs -> nthreads);
+			break;
+		case TUNE_SCHEDULER:
+			snprintf(buffer, size, "%s", schedulerName(configs -> scheduler));
+			break;
+		case TUNE_BATCH:
+			snprintf(buffer, size, "%lu", (configs -> batchSize) ?
+			         configs -> batchSize : (uint64_t) BATCH_SIZE);
+			break;
+		case TUNE_KERNEL:
+			snprintf(buffer, size, "%s", kernelName(configs -> kernel));
+			break;
+		case TUNE_PINNING:
+			snprintf(buffer, size, "%s", pinningName(configs -> pinning));
+			break;
+		default:
+			buffer[0] = '\0';
+			break;
+	}
+}
+
+int compareTimes(const void* a, const void* b) {
+
+	double first = *(const double*) a, second = *(const double*) b;
+
+	return (first > second) - (first < second);
+}
+
+double medianTime(Config* configs) {
+
+	double times[TUNE_RUNS];
+
+	for (int i = 0; i < TUNE_RUNS; i++) {
+		BBPStats stats;
+
+		if (isnan(evalBBP(configs, &stats)))
+			return NAN;
+
+		times[i] = stats.totalTime;
+	}
+
+	qsort(times, TUNE_RUNS, sizeof(double), compareTimes);
+
+	return times[TUNE_RUNS / 2];
+}
+
+int quickBenchmark(Config* configs) {
+
+	Config best = *configs;
+	double bestTime;
+
+	if (best.startPos < TUNE_MIN_OFFSET)
+		best.startPos = TUNE_MIN_OFFSET;
+
+	if (best.startPos > TUNE_MAX_OFFSET)
+		best.startPos = TUNE_MAX_OFFSET;
+
+	// More Threads Than CPUs Only Add Switching
+	if (!best.nthreads || best.nthreads > getTopology() -> total)
+		best.nthreads = (best.nthreads) ? getTopology() -> total : 1;
+
+	printf("\nQuick Benchmark: %s at Offset %lu, Median of %d Runs\n",
+	       getFormula(best.algo) -> key, best.startPos, TUNE_RUNS);
+
+	// First Run Only Warms Caches and Clock Frequency
+	evalBBP(&best, NULL);
+	bestTime = medianTime(&best);
+
+	if (isnan(bestTime)) {
+		fprintf(stderr, "\nAlgorithm Not Found or Offset Too Large For Formula!\n");
+		return 1;
+	}
+
+	printf("Current Settings: %.5fs\n", bestTime);
+
+	for (int setting = 0; setting < TOTAL_TUNED; setting++) {
+		uint64_t values[MAX_CANDIDATES];
+		int total = candidates(setting, values);
+
+		// Pinning Changes Nothing For a Single Thread
+		if (setting == TUNE_PINNING && best.nthreads == 1)
+			continue;
+
+		printf("\n%s:\n", tunedNames[setting]);
+
+		for (int i = 0; i < total; i++) {
+			Config trial = best;
+			char text[32];
+			double time;
+
+			applySetting(&trial, setting, values[i]);
+			settingText(&trial, setting, text, sizeof(text));
+			time = medianTime(&trial);
+
+			if (isnan(time))
+				continue;
+
+			printf("  %-10s %.5fs%s\n", text, time, (time < TUNE_MARGIN * bestTime) ? " *" : "");
+
+			if (time < TUNE_MARGIN * bestTime) {
+				bestTime = time;
+				best = trial;
+			}
+		}
+	}
+
+	printf("\nSuggested: %d Threads, Batch Size %lu, %s Kernel, %s Pinning, %s Scheduler (%.5fs)\n",
+	       best.nthreads, (best.batchSize) ? best.batchSize : (uint64_t) BATCH_SIZE,
+	       kernelName(best.kernel), pinningName(best.pinning),
+	       schedulerName(best.scheduler), bestTime);
+	printf("Applied to Current Settings.\n");
+
+	configs -> nthreads = best.nthreads;
+	configs -> batchSize = best.batchSize;
+	configs -> kernel = best.kernel;
+	configs -> pinning = best.pinning;
+	configs -> scheduler = best.scheduler;
+
+	return 0;
+}
@@ -0,0 +1,558 @@
+/*-----------------------------------------------------------------*/
+/**
+  @file   verify.c
+  @author Flávio M.
+  @brief  Self Check of Digits, Modular Arithmetic and Performance.
+ */
+/*-----------------------------------------------------------------*/
+
+/*-----------------------------------------------------------------
+                              Includes
+  -----------------------------------------------------------------*/
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdatomic.h>
+#include "../include/async.h"
+#include "../include/bbp.h"
+#include "../include/formula.h"
+#include "../include/modular.h"
+#include "../include/verify.h"
+
+
+/*-----------------------------------------------------------------
+                            Definitions
+-----------------------------------------------------------------*/
+#define CHECKED_BITS 32         // Bits of Result That Must Match (8 Hex Digits)
+#define MODPOW_CASES 200000     // Random Cases of Differential Check
+#define MAX_MODULUS_BITS 40     // Largest Modulus Checked (Offsets Up to ~10^11)
+#define WIDE_CASES 2000         // Random Cases of 128-Bit Check (Slow Reference)
+#define INVERSE_BATCH 8         // Numbers Per batchInverse Call
+#define CANCEL_OFFSET 1000000000ULL // Offset of Job Cancelled by Async Check
+#define CANCEL_TIMEOUT 5.0      // Seconds For a Cancelled Job to Settle
+#define PERF_ALGO "bellard"     // Formula of Performance Reference Run
+#define PERF_OFFSET 1000000     // Offset of Performance Reference Run
+#define PERF_TOLERANCE 0.10     // Max Drop of Terms Per Second
+
+
+/*-----------------------------------------------------------------
+                          Structs and Enums
+-----------------------------------------------------------------*/
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief Known Hex Digits of a Formula at an Offset. Key "pi" is
+          Checked With Every Formula of Pi.
+*/
+/*-----------------------------------------------------------------*/
+typedef struct {
+	const char* key;
+	uint64_t offset;
+	const char* digits;
+} Vector;
+
+
+/*-----------------------------------------------------------------
+                          Global Variables
+-----------------------------------------------------------------*/
+static const char* piFormulas[] = {"bellard", "original", "adamchik"};
+
+static const Vector vectors[] = {
+	// Bellard Bounds Negative or Zero
+	{"pi", 0, "243F6A8885A308"},
+	{"pi", 1, "43F6A8885A308D"},
+	{"pi", 2, "3F6A8885A308D3"},
+	{"pi", 3, "F6A8885A308D31"},
+	// Upper Bound Smaller Than a Batch
+	{"pi", 7, "885A308D313198"},
+	{"pi", 8, "85A308D313198A"},
+	{"pi", 9, "5A308D313198A2"},
+	{"pi", 10, "A308D313198A2E"},
+	{"pi", 12, "08D313198A2E03"},
+	{"pi", 24, "03707344A40938"},
+	{"pi", 25, "3707344A409382"},
+	{"pi", 100, "29B7C97C50DD3F"},
+	// Many Batches
+	{"pi", 1000, "49F1C09B075372"},
+	{"pi", 10000, "8AC8FCFB8016CB"},
+	{"pi", 100000, "35EA16C406363A"},
+	{"pi", 1000000, "6C65E52CB45935"},
+	{"pi", 2500000, "6CFDD54E3B63FF"},
+	{"pi", 10000000, "7AF5863EFED8DE"},
+	{"log2", 0, "B17217F7D1CF79"},
+	{"log2", 1, "17217F7D1CF79A"},
+	{"log2", 1000, "A892374E175EB4"},
+	{"log2", 100000, "DEEFD62B1B62F8"},
+	{"pi2", 0, "DE9E64DF22"},
+	{"pi2", 1000, "29F3AB730B"},
+};
+
+
+/*-----------------------------------------------------------------
+                   Internal Functions Signatures
+  -----------------------------------------------------------------*/
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Check a Formula Against Known Digits.
+   @param  const char*   Key of Formula.
+   @param  const Vector* Known Digits.
+   @param  uint16_t      Number of Threads.
+   @return int           Failed(1) /Passed(0).
+*/
+/*-----------------------------------------------------------------*/
+int checkVector(const char*, const Vector*, uint16_t);
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Compare modPowBarret Against Square and Multiply With
+           128-Bit Remainders, For Random and Edge Moduli.
+   @return int Number of Mismatches.
+*/
+/*-----------------------------------------------------------------*/
+int checkModPow();
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Compare The Montgomery Paths (modPow2Mont, modPow2Wide)
+           Against Reference Exponentiations, Across Every Modulus
+           Size They Accept, Odd and Even.
+   @return int Number of Mismatches.
+*/
+/*-----------------------------------------------------------------*/
+int checkMontgomery();
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Compare barrettFactor, Fed by batchInverse Over Runs of
+           Consecutive Moduli Like The Kernels, Against The Hardware
+           Divide floor((2^64 - 1) / base), For Every Modulus Size.
+   @return int Number of Mismatches.
+*/
+/*-----------------------------------------------------------------*/
+int checkReciprocals();
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Run The Known Digits Through The Asynchronous API, All
+           Jobs Sharing The Pool, Then Cancel a Long Job.
+   @param  uint16_t Number of Pool Workers.
+   @return int      Number of Failures.
+*/
+/*-----------------------------------------------------------------*/
+int checkAsync(uint16_t);
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Completion Callback of Async Check, Counts Settled Jobs.
+   @param  BBPFuture* Settled Future.
+   @param  void*      Counter (atomic_int*).
+*/
+/*-----------------------------------------------------------------*/
+void countSettled(BBPFuture*, void*);
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Reference Power of Two Modulo a 128-Bit Number.
+   @param  __uint128_t Exponent (exp).
+   @param  __uint128_t Base of Current Operation.
+   @return __uint128_t 2^exp mod base.
+*/
+/*-----------------------------------------------------------------*/
+__uint128_t referenceModPow2Wide(__uint128_t, __uint128_t);
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Reference Modular Exponentiation (n^exp mod base).
+   @param  uint64_t Number (n).
+   @param  uint64_t Exponent (exp).
+   @param  uint64_t Base of Current Operation.
+   @return uint64_t n^exp mod base.
+*/
+/*-----------------------------------------------------------------*/
+uint64_t referenceModPow(uint64_t, uint64_t, uint64_t);
+
+
+/*-----------------------------------------------------------------*/
+/**
+   @brief  Xorshift Generator, Fixed Seed Keeps Runs Reproducible.
+   @param  uint64_t* State of Generator.
+   @return uint64_t  Next Number.
+*/
+/*-----------------------------------------------------------------*/
+uint64_t nextRandom(uint64_t*);
+
+
+/*-----------------------------------------------------------------
+                      Functions Implementation
+  -----------------------------------------------------------------*/
+uint64_t nextRandom(uint64_t* state) {
+
+	*state ^= *state << 13;
+	*state ^= *state >> 7;
+	*state ^= *state << 17;
+
+	return *state;
+}
+
+uint64_t referenceModPow(uint64_t n, uint64_t exp, uint64_t base) {
+
+	__uint128_t result = 1 % base, square = n % base;
+
+	while (exp) {
+
+		if (exp & 1)
+			result = (result * square) % base;
+
+		square = (square * square) % base;
+		exp >>= 1;
+	}
+
+	return result;
+}
+
+__uint128_t referenceModPow2Wide(__uint128_t exp, __uint128_t base) {
+
+	__uint128_t result = 1 % base, square = 2 % base;
+
+	while (exp) {
+
+		if (exp & 1)
+			result = mulModSlow(result, square, base);
+
+		square = mulModSlow(square, square, base);
+		exp >>= 1;
+	}
+
+	return result;
+}
+
+int checkVector(const char* key, const Vector* vector, uint16_t nthreads) {
+
+	Config configs = {vector -> offset, nthreads, 0, REPORT_TEXT};
+	BBPStats stats;
+	long double result, expected, error;
+	int algo = findFormula(key);
+	int known = strlen(vector -> digits);
+
+	if (algo == -1) {
+		printf("[FAIL] %-8s Formula Not Found\n", key);
+		return 1;
+	}
+
+	configs.algo = algo;
+	configs.digits = (known < MAX_DIGITS) ? known : MAX_DIGITS;
+	result = evalBBP(&configs, &stats);
+	result -= floorl(result);
+	expected = ldexpl(strtoull(vector -> digits, NULL, 16), -4 * known);
+
+	// Distance on The Circle, 0.FFFF... is Next to 0.0000...
+	error = fabsl(result - expected);
+
+	if (error > 0.5L)
+		error = 1.0L - error;
+
+	if (error >= ldexpl(1.0L, -CHECKED_BITS)) {
+		printf("[FAIL] %-8s @ %-9lu = %016lX, Expected %s\n", key,
+		       vector -> offset, (uint64_t) ldexpl(result, 64), vector -> digits);
+		return 1;
+	}
+
+	// Known Digits Are Truncated, True Value is Up to One Digit Above
+	if (error > stats.errorBound + ldexpl(1.0L, -4 * known)) {
+		printf("[FAIL] %-8s @ %-9lu Error %.3Le Above its Bound %.3Le\n", key,
+		       vector -> offset, error, stats.errorBound);
+		return 1;
+	}
+
+	printf("[PASS] %-8s @ %-9lu = %.10s (%d Guaranteed)\n", key, vector -> offset,
+	       vector -> digits, stats.guaranteedDigits);
+
+	return 0;
+}
+
+int checkModPow() {
+
+	static const uint64_t edges[] = {
+		2, 3, 5, 15, 16, 17, 255, 65537,
+		(1ULL << 31) - 1, (1ULL << 32) - 1, 1ULL << 32, (1ULL << 32) + 1,
+		(1ULL << MAX_MODULUS_BITS) - 1
+	};
+	uint64_t state = 0x9E3779B97F4A7C15ULL;
+	int failed = 0;
+
+	for (int i = 0; i < MODPOW_CASES; i++) {
+		uint64_t base, n, exp;
+		int bits = 2 + i % (MAX_MODULUS_BITS - 1);
+
+		if (i < (int) (sizeof(edges) / sizeof(uint64_t))) {
+			base = edges[i];
+		} else {
+			base = nextRandom(&state) >> (64 - bits);
+			base |= 1ULL << (bits - 1);
+		}
+
+		// Engine Uses Small Powers of Two, Also Check Any n < base
+		n = (i & 1) ? nextRandom(&state) % base : 1ULL << (1 + i % 4);
+		exp = nextRandom(&state) >> (i % 64);
+
+		if (modPowBarret(n, exp, base) != referenceModPow(n, exp, base)) {
+
+			if (failed < 10)
+				printf("[FAIL] modPowBarret(%lu, %lu, %lu) = %lu, Expected %lu\n",
+				       n, exp, base, modPowBarret(n, exp, base),
+				       referenceModPow(n, exp, base));
+			failed++;
+		}
+	}
+
+	if (!failed)
+		printf("[PASS] modPowBarret Matches Reference in %d Cases\n", MODPOW_CASES);
+
+	return failed;
+}
+
+int checkMontgomery() {
+
+	uint64_t state = 0xD1B54A32D192ED03ULL;
+	int failed = 0;
+
+	for (int i = 0; i < MODPOW_CASES; i++) {
+		int bits = 2 + i % (MONT_MAX_BITS - 1);
+		uint64_t base = (nextRandom(&state) >> (64 - bits)) | (1ULL << (bits - 1));
+		uint64_t exp = nextRandom(&state) >> (i % 64);
+
+		// Even Moduli Are Split in Powers of Two and an Odd Part
+		if (i & 2)
+			base &= ~1ULL;
+
+		if (base < 2)
+			continue;
+
+		if (modPow2Mont(exp, base) != referenceModPow(2, exp, base)) {
+
+			if (failed < 10)
+				printf("[FAIL] modPow2Mont(%lu, %lu) = %lu, Expected %lu\n",
+				       exp, base, modPow2Mont(exp, base),
+				       referenceModPow(2, exp, base));
+			failed++;
+		}
+	}
+
+	for (int i = 0; i < WIDE_CASES; i++) {
+		int bits = 2 + i % (WIDE_MAX_BITS - 1);
+		__uint128_t base = ((__uint128_t) nextRandom(&state) << 64) | nextRandom(&state);
+		__uint128_t exp = ((__uint128_t) nextRandom(&state) << 64) | nextRandom(&state);
+
+		base = (base >> (128 - bits)) | ((__uint128_t) 1 << (bits - 1));
+		exp >>= i % 128;
+
+		if (i & 2)
+			base &= ~(__uint128_t) 1;
+
+		if (base < 2)
+			continue;
+
+		if (modPow2Wide(exp, base) != referenceModPow2Wide(exp, base)) {
+
+			if (failed < 10)
+				printf("[FAIL] modPow2Wide Mismatch With %d-Bit Modulus\n", bits);
+			failed++;
+		}
+	}
+
+	if (!failed)
+		printf("[PASS] modPow2Mont/modPow2Wide Match Reference in %d Cases\n",
+		       MODPOW_CASES + WIDE_CASES);
+
+	return failed;
+}
+
+int checkReciprocals() {
+
+	uint64_t state = 0x2545F4914F6CDD1DULL;
+	long double x[INVERSE_BATCH], inverse[INVERSE_BATCH];
+	int failed = 0;
+
+	for (int i = 0; i < MODPOW_CASES / INVERSE_BATCH; i++) {
+		int bits = 1 + i % 62;
+		uint64_t first = (nextRandom(&state) >> (64 - bits)) | 1;
+
+		// Small Moduli, Where The Kernels Start, Are Checked First
+		if (i < 1000)
+			first = 1 + i * INVERSE_BATCH;
+
+		for (int c = 0; c < INVERSE_BATCH; c++)
+			x[c] = (int64_t) (first + c);
+
+		batchInverse(x, inverse, INVERSE_BATCH);
+
+		for (int c = 0; c < INVERSE_BATCH; c++) {
+			uint64_t base = first + c;
+
+			if (barrettFactor(base, inverse[c]) != UINT64_MAX / base) {
+
+				if (failed < 10)
+					printf("[FAIL] barrettFactor(%lu) = %lu, Expected %lu\n",
+					       base, barrettFactor(base, inverse[c]),
+					       UINT64_MAX / base);
+				failed++;
+			}
+		}
+	}
+
+	if (!failed)
+		printf("[PASS] barrettFactor/batchInverse Match Divides in %d Cases\n",
+		       MODPOW_CASES);
+
+	return failed;
+}
+
+void countSettled(BBPFuture* future, void* counter) {
+
+	(void) future;
+	atomic_fetch_add((atomic_int*) counter, 1);
+}
+
+int checkAsync(uint16_t nthreads) {
+
+	int totalVectors = sizeof(vectors) / sizeof(Vector);
+	BBPFuture* futures[totalVectors];
+	BBPFuture* cancelled;
+	Config configs = {0, 1, findFormula("bellard"), REPORT_TEXT};
+	atomic_int settled = 0;
+	int failed = 0, submitted = 0;
+
+	if (initAsync(nthreads, PIN_NONE)) {
+		printf("[FAIL] Worker Pool Couldn't Start\n");
+		return 1;
+	}
+
+	// Long Job Competes With The Others Until They Finish
+	configs.startPos = CANCEL_OFFSET;
+	cancelled = submitBBP(&configs, NULL, &countSettled, &settled);
+
+	for (int i = 0; i < totalVectors; i++) {
+
+		if (strcmp(vectors[i].key, "pi")) {
+			futures[i] = NULL;
+			continue;
+		}
+
+		// Every Scheduler Shares The Pool
+		configs.startPos = vectors[i].offset;
+		configs.scheduler = submitted % TOTAL_SCHEDULERS;
+		futures[i] = submitBBP(&configs, NULL, &countSettled, &settled);
+		submitted++;
+	}
+
+	// Same Fixed-Point Sums, Results Must Match Bit by Bit
+	for (int i = 0; i < totalVectors; i++) {
+		long double result, expected;
+
+		if (!futures[i])
+			continue;
+
+		configs.startPos = vectors[i].offset;
+		expected = evalBBP(&configs, NULL);
+
+		if (waitBBP(futures[i], &result) != FUTURE_DONE || result != expected) {
+			printf("[FAIL] Async   @ %-9lu Differs From Synchronous Run\n",
+			       vectors[i].offset);
+			failed++;
+		}
+
+		freeFuture(futures[i]);
+	}
+
+	// Smaller Jobs Ran First, The Long One Only Got Aged Batches
+	cancelBBP(cancelled);
+
+	if (timedWaitBBP(cancelled, CANCEL_TIMEOUT, NULL) != FUTURE_CANCELLED) {
+		printf("[FAIL] Async   Cancelled Job Didn't Settle in %.0fs\n", CANCEL_TIMEOUT);
+		failed++;
+	}
+
+	freeFuture(cancelled);
+	freeAsync();
+
+	if (settled != submitted + 1) {
+		printf("[FAIL] Async   %d Callbacks For %d Jobs\n", (int) settled, submitted + 1);
+		failed++;
+	}
+
+	if (!failed)
+		printf("[PASS] Async   %d Jobs Match, Cancelled Job Released\n", submitted);
+
+	return failed;
+}
+
+int runVerify(uint16_t nthreads, double baseline) {
+
+	Config configs = {PERF_OFFSET, 1, 0, REPORT_TEXT};
+	BBPStats stats;
+	double termsPerSec;
+	int failed = 0, total = 0;
+	int totalVectors = sizeof(vectors) / sizeof(Vector);
+
+	printf("\nKnown Digits (%d Threads):\n", nthreads);
+
+	for (int i = 0; i < totalVectors; i++) {
+
+		if (strcmp(vectors[i].key, "pi")) {
+			failed += checkVector(vectors[i].key, vectors + i, nthreads);
+			total++;
+			continue;
+		}
+
+		for (size_t j = 0; j < sizeof(piFormulas) / sizeof(char*); j++) {
+			failed += checkVector(piFormulas[j], vectors + i, nthreads);
+			total++;
+		}
+	}
+
+	printf("\nModular Arithmetic:\n");
+	failed += (checkModPow() != 0);
+	failed += (checkMontgomery() != 0);
+	failed += (checkReciprocals() != 0);
+	total += 3;
+
+	printf("\nAsynchronous Jobs (%d Workers):\n", nthreads);
+	failed += (checkAsync(nthreads) != 0);
+	total++;
+
+	// Single Thread, Independent of The Machine Load
+	printf("\nPerformance (%s @ %d, 1 Thread):\n", PERF_ALGO, PERF_OFFSET);
+	configs.algo = findFormula(PERF_ALGO);
+	evalBBP(&configs, &stats);
+	termsPerSec = stats.terms / stats.totalTime;
+	printf("       %.0f terms/s", termsPerSec);
+
+	if (baseline > 0.0) {
+		total++;
+
+		if (termsPerSec < baseline * (1.0 - PERF_TOLERANCE)) {
+			printf(" (Baseline %.0f, Dropped %.1f%%)\n[FAIL] Performance Below Baseline\n",
+			       baseline, 100.0 * (1.0 - termsPerSec / baseline));
+			failed++;
+		} else {
+			printf(" (Baseline %.0f)\n[PASS] Performance Within %.0f%% of Baseline\n",
+			       baseline, 100.0 * PERF_TOLERANCE);
+		}
+	} else {
+		printf("\n");
+	}
+
+	printf("\n%d/%d Checks Passed\n", total - failed, total);
+
+	return failed;
+}